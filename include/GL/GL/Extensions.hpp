@@ -209,6 +209,10 @@ extern GLUNIFORMMATRIX4X3FV glUniformMatrix4x3fv;
 #define GL_ARRAY_BUFFER 0x8892
 #define GL_ELEMENT_ARRAY_BUFFER 0x8893
 
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+
 typedef void ( APIENTRYP GLGENBUFFERS ) ( GLsizei n, GLuint* buffers );
 extern GLGENBUFFERS glGenBuffers;
 typedef void ( APIENTRYP GLDELETEBUFFERS ) ( GLsizei n, const GLuint* buffers );
@@ -221,6 +225,10 @@ typedef void ( APIENTRYP GLBUFFERSUBDATA ) ( GLenum target, GLintptr offset, GLs
 extern GLBUFFERSUBDATA glBufferSubData;
 typedef void ( APIENTRYP GLGETBUFFERSUBDATA ) ( GLenum target, GLintptr offset, GLsizeiptr size, GLvoid* data );
 extern GLGETBUFFERSUBDATA glGetBufferSubData;
+typedef GLvoid* ( APIENTRYP GLMAPBUFFERRANGE ) ( GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access );
+extern GLMAPBUFFERRANGE glMapBufferRange;
+typedef GLboolean ( APIENTRYP GLUNMAPBUFFER ) ( GLenum target );
+extern GLUNMAPBUFFER glUnmapBuffer;
 
 /*
 	VAOs
@@ -237,6 +245,8 @@ typedef void ( APIENTRYP GLENABLEVERTEXATTRIBARRAY ) ( GLuint index );
 extern GLENABLEVERTEXATTRIBARRAY glEnableVertexAttribArray;
 typedef void ( APIENTRYP GLVERTEXATTRIBPOINTER ) ( GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* pointer );
 extern GLVERTEXATTRIBPOINTER glVertexAttribPointer;
+typedef void ( APIENTRYP GLVERTEXATTRIBIPOINTER ) ( GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid* pointer );
+extern GLVERTEXATTRIBIPOINTER glVertexAttribIPointer;
 
 /*
 	Textures
@@ -42,7 +42,11 @@ namespace GL
 		operator GLuint() const;
 		const VertexArray& operator=( const VertexArray& other );
 
-		void BindAttribute( const Attribute& attribute, const VertexBuffer& buffer, Type::type_t type, uint count, uint stride, intptr_t offset );
+		// Normalized integer data is mapped to [0, 1] or [-1, 1], otherwise it is converted to float as is
+		void BindAttribute( const Attribute& attribute, const VertexBuffer& buffer, Type::type_t type, uint count, uint stride, intptr_t offset, bool normalized = false );
+
+		// Binds integer data to an int/uint/ivecn/uvecn shader attribute without conversion
+		void BindIntegerAttribute( const Attribute& attribute, const VertexBuffer& buffer, Type::type_t type, uint count, uint stride, intptr_t offset );
 
 		void BindElements( const VertexBuffer& elements );
 
@@ -29,7 +29,9 @@
 #include <GL/GL/Extensions.hpp>
 #include <GL/Util/Mesh.hpp>
 #include <GL/Math/Vec4.hpp>
-#include <functional>
+#include <vector>
+#include <memory>
+#include <cstring>
 #include <cstdint>
 
 namespace GL
@@ -53,34 +55,124 @@ namespace GL
 		};
 	}
 
+	/*
+		Layout of meshes packed with VertexDataBuffer::Pack, which is half the
+		size of the full precision layout
+
+		Position: 4 x Type::HalfFloat with W = 1
+		Normal: 4 x Type::Int2101010Rev, normalized
+		TexCoord: 2 x Type::UnsignedShort, normalized, clamped to [0, 1]
+	*/
+	namespace PackedVertex
+	{
+		enum packed_vertex_t
+		{
+			Stride = 16,
+			PositionOffset = 0,
+			NormalOffset = 8,
+			TexCoordOffset = 12
+		};
+	}
+
+	/*
+		Exceptions
+	*/
+	class VertexDataOverflowException : public std::exception
+	{
+		virtual const char* what() const throw()
+		{
+			return "Vertex data does not fit in the target memory!";
+		}
+	};
+
+	/*
+		Largest difference between the original and packed attributes
+	*/
+	struct PackError
+	{
+		float Position;
+		float Normal;
+		float TexCoord;
+	};
+
 	/*
 		Helper class for building vertex data
 	*/
 	class VertexDataBuffer
 	{
 	public:
-		void Float( float v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Int8( int8_t v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Int16( int16_t v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Int32( int32_t v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Uint8( uint8_t v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Uint16( uint16_t v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Uint32( uint32_t v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
+		VertexDataBuffer();
+		VertexDataBuffer( const VertexDataBuffer& other );
+
+		// Writes into external memory of a fixed size instead, such as a mapped
+		// VertexBuffer, and throws VertexDataOverflowException when it is full
+		VertexDataBuffer( void* memory, size_t capacity );
+
+		const VertexDataBuffer& operator=( const VertexDataBuffer& other );
+
+		// Allocates room for at least this many bytes in total
+		void Reserve( size_t bytes );
+
+		void Float( float v ) { Write( v ); }
+		void Int8( int8_t v ) { Write( v ); }
+		void Int16( int16_t v ) { Write( v ); }
+		void Int32( int32_t v ) { Write( v ); }
+		void Uint8( uint8_t v ) { Write( v ); }
+		void Uint16( uint16_t v ) { Write( v ); }
+		void Uint32( uint32_t v ) { Write( v ); }
 		
-		void Vec2( const Vec2& v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Vec3( const Vec3& v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
-		void Vec4( const Vec4& v ) { Bytes( (uchar*)&v, sizeof( v ) ); }
+		void Vec2( const Vec2& v ) { Write( v ); }
+		void Vec3( const Vec3& v ) { Write( v ); }
+		void Vec4( const Vec4& v ) { Write( v ); }
+
+		void Bytes( const void* bytes, size_t count )
+		{
+			if ( count > capacity - size ) Grow( count );
+			memcpy( start + size, bytes, count );
+			size += count;
+		}
+
+		// Half precision floats, Vec3Half is padded with W = 1 to keep attributes 4 byte aligned
+		void Half( float v );
+		void Vec2Half( const GL::Vec2& v );
+		void Vec3Half( const GL::Vec3& v );
+		void Vec4Half( const GL::Vec4& v );
+
+		// Unit normal as 4 x Type::Int2101010Rev, bind as normalized
+		void Normal2101010( const GL::Vec3& n );
+
+		// Tangent from Mesh::Tangents as 4 x Type::Int2101010Rev, bind as normalized,
+		// the bitangent sign ends up in W as -1 or 1
+		void Tangent2101010( const GL::Vec4& t );
+
+		// Unit normal as 2 x Type::Short octahedral coordinates, bind as normalized and decode in the shader:
+		// n = vec3( e, 1 - abs( e.x ) - abs( e.y ) ); if ( n.z < 0 ) n.xy = ( 1 - abs( n.yx ) ) * sign( n.xy ); n = normalize( n );
+		void NormalOctahedral( const GL::Vec3& n );
+
+		// Coordinates in [0, 1] as 2 x Type::UnsignedShort, bind as normalized
+		void Vec2Unorm16( const GL::Vec2& v );
+
+		// Appends all vertices of the mesh in the PackedVertex layout
+		PackError Pack( const Mesh& mesh );
 
-		void* Pointer() { return &data[0]; }
-		int Size() { return data.size(); }
+		void* Pointer() { return start; }
+		size_t Size() { return size; }
 
 	private:
-		std::vector<uchar> data;
+		std::unique_ptr<uchar[]> owned;
+		uchar* start;
+		size_t size, capacity;
+		bool external;
 
-		void Bytes( uchar* bytes, uint count ) {
-			for ( uint i = 0; i < count; i++ )
-				data.push_back( bytes[i] );
+		template <typename T>
+		void Write( const T& v )
+		{
+			if ( sizeof( T ) > capacity - size ) Grow( sizeof( T ) );
+			memcpy( start + size, &v, sizeof( T ) );
+			size += sizeof( T );
 		}
+
+		void Grow( size_t count );
 	};
 
 	/*
@@ -92,7 +184,13 @@ namespace GL
 		VertexBuffer();
 		VertexBuffer( const VertexBuffer& other );
 		VertexBuffer( const void* data, size_t length, BufferUsage::buffer_usage_t usage );
-		VertexBuffer( const Mesh& mesh, BufferUsage::buffer_usage_t usage, std::function<void ( const Vertex& v, VertexDataBuffer& data )> f );
+
+		// Creates a buffer with the data written by f( const Vertex& v, VertexDataBuffer& data ) for every vertex
+		template <typename F>
+		VertexBuffer( const Mesh& mesh, BufferUsage::buffer_usage_t usage, F f );
+
+		// Creates an element buffer from the indices of an indexed mesh, stored as Mesh::IndexType()
+		VertexBuffer( const Mesh& mesh, BufferUsage::buffer_usage_t usage );
 
 		~VertexBuffer();
 
@@ -104,10 +202,36 @@ namespace GL
 
 		void GetSubData( void* data, size_t offset, size_t length );
 
+		// Maps a range for writing, its previous contents are discarded. Unmap
+		// returns false if the contents were lost while mapped and have to be
+		// written again.
+		void* MapWrite( size_t offset, size_t length );
+		bool Unmap();
+
 	private:
 		static GC gc;
 		GLuint obj;
 	};
+
+	template <typename F>
+	VertexBuffer::VertexBuffer( const Mesh& mesh, BufferUsage::buffer_usage_t usage, F f )
+	{
+		VertexDataBuffer data;
+		const Vertex* vertices = mesh.Vertices();
+		uint count = mesh.VertexCount();
+
+		// All vertices are assumed to take as much room as the first one
+		if ( count > 0 ) {
+			f( vertices[0], data );
+			data.Reserve( data.Size() * count );
+		}
+
+		for ( uint i = 1; i < count; i++ )
+			f( vertices[i], data );
+
+		gc.Create( obj, glGenBuffers, glDeleteBuffers );
+		Data( data.Pointer(), data.Size(), usage );
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_AABB_HPP
+#define OOGL_AABB_HPP
+
+#include <GL/Math/Vec3.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <cfloat>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Axis-aligned bounding box
+	*/
+	class AABB
+	{
+	public:
+		// The default box is empty and takes the shape of whatever it is extended with
+		OOGL_CONSTEXPR AABB();
+		OOGL_CONSTEXPR AABB( const Vec3& min, const Vec3& max );
+
+		void Extend( const Vec3& v );
+		void Extend( const AABB& box );
+
+		bool IsEmpty() const;
+		const Vec3 Center() const;
+		const Vec3 Size() const;
+		float SurfaceArea() const;
+
+		bool Contains( const Vec3& v ) const;
+		bool Intersects( const AABB& box ) const;
+
+		// Smallest box containing this box after transformation
+		AABB Transform( const Mat4& mat ) const;
+
+		Vec3 Min, Max;
+	};
+
+	inline OOGL_CONSTEXPR AABB::AABB() : Min( FLT_MAX, FLT_MAX, FLT_MAX ), Max( -FLT_MAX, -FLT_MAX, -FLT_MAX )
+	{
+	}
+
+	inline OOGL_CONSTEXPR AABB::AABB( const Vec3& min, const Vec3& max ) : Min( min ), Max( max )
+	{
+	}
+
+	inline void AABB::Extend( const Vec3& v )
+	{
+		// Plain comparisons, std::min and std::max clash with the macros in Windows.h
+		Min = Vec3( v.X < Min.X ? v.X : Min.X, v.Y < Min.Y ? v.Y : Min.Y, v.Z < Min.Z ? v.Z : Min.Z );
+		Max = Vec3( v.X > Max.X ? v.X : Max.X, v.Y > Max.Y ? v.Y : Max.Y, v.Z > Max.Z ? v.Z : Max.Z );
+	}
+
+	inline void AABB::Extend( const AABB& box )
+	{
+		const Vec3& lo = box.Min;
+		const Vec3& hi = box.Max;
+		Min = Vec3( lo.X < Min.X ? lo.X : Min.X, lo.Y < Min.Y ? lo.Y : Min.Y, lo.Z < Min.Z ? lo.Z : Min.Z );
+		Max = Vec3( hi.X > Max.X ? hi.X : Max.X, hi.Y > Max.Y ? hi.Y : Max.Y, hi.Z > Max.Z ? hi.Z : Max.Z );
+	}
+
+	inline bool AABB::IsEmpty() const
+	{
+		return Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z;
+	}
+
+	inline const Vec3 AABB::Center() const
+	{
+		return ( Min + Max ) * 0.5f;
+	}
+
+	inline const Vec3 AABB::Size() const
+	{
+		return IsEmpty() ? Vec3() : Max - Min;
+	}
+
+	inline float AABB::SurfaceArea() const
+	{
+		Vec3 s = Size();
+		return 2.0f * ( s.X * s.Y + s.Y * s.Z + s.Z * s.X );
+	}
+
+	inline bool AABB::Contains( const Vec3& v ) const
+	{
+		return v.X >= Min.X && v.Y >= Min.Y && v.Z >= Min.Z && v.X <= Max.X && v.Y <= Max.Y && v.Z <= Max.Z;
+	}
+
+	inline bool AABB::Intersects( const AABB& box ) const
+	{
+		return Min.X <= box.Max.X && Min.Y <= box.Max.Y && Min.Z <= box.Max.Z && Max.X >= box.Min.X && Max.Y >= box.Min.Y && Max.Z >= box.Min.Z;
+	}
+
+	inline AABB AABB::Transform( const Mat4& mat ) const
+	{
+		if ( IsEmpty() ) return *this;
+
+		// Transform the center and add the extents projected onto every axis
+		Vec3 center = mat * Center();
+		Vec3 e = ( Max - Min ) * 0.5f;
+		const float* m = mat.m;
+
+		Vec3 extents(
+			fabsf( m[0] ) * e.X + fabsf( m[4] ) * e.Y + fabsf( m[8] ) * e.Z,
+			fabsf( m[1] ) * e.X + fabsf( m[5] ) * e.Y + fabsf( m[9] ) * e.Z,
+			fabsf( m[2] ) * e.X + fabsf( m[6] ) * e.Y + fabsf( m[10] ) * e.Z
+		);
+
+		return AABB( center - extents, center + extents );
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_DUALQUAT_HPP
+#define OOGL_DUALQUAT_HPP
+
+#include <GL/Math/Util.hpp>
+#include <GL/Math/Vec3.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <GL/Math/Quat.hpp>
+#include <cstddef>
+
+namespace GL
+{
+	/*
+		Dual quaternion
+
+		Rigid transformation, a rotation followed by a translation, stored as
+		Real + e * Dual. Products compose like Mat4 products. Skinning with
+		blended dual quaternions avoids the shrinking of blended matrices around
+		twisted joints.
+	*/
+	class DualQuat
+	{
+	public:
+		OOGL_CONSTEXPR DualQuat( const Quat& real = Quat(), const Quat& dual = Quat( 0.0f, 0.0f, 0.0f, 0.0f ) ) : Real( real ), Dual( dual ) {}
+		DualQuat( const Quat& rotation, const Vec3& translation );
+
+		// Matrix that only rotates and translates
+		explicit DualQuat( const Mat4& mat );
+
+		const DualQuat operator*( const DualQuat& dq ) const;
+		DualQuat& operator*=( const DualQuat& dq );
+
+		// Transforms the point v
+		const Vec3 operator*( const Vec3& v ) const;
+
+		DualQuat Normal() const;
+
+		// Inverse of a normalized dual quaternion
+		OOGL_CONSTEXPR DualQuat Conjugate() const;
+
+		const Quat& Rotation() const;
+		Vec3 Translation() const;
+
+		Mat4 ToMat4() const;
+
+		// Normalized weighted sum, where every quaternion is first flipped into the
+		// hemisphere of the first one to blend along the shortest arc
+		static DualQuat Blend( const DualQuat* dq, const float* weights, size_t count );
+
+		// Batch versions for skinning palettes, out[i] = a[i] * b[i] and
+		// out[i] = dq[i].ToMat4(), out may be a or b
+		static void Multiply( const DualQuat* a, const DualQuat* b, DualQuat* out, size_t count );
+		static void ToMat4( const DualQuat* dq, Mat4* out, size_t count );
+
+		Quat Real, Dual;
+	};
+
+	inline DualQuat::DualQuat( const Quat& rotation, const Vec3& translation ) : Real( rotation )
+	{
+		Dual = Quat( translation.X, translation.Y, translation.Z, 0.0f ) * rotation * 0.5f;
+	}
+
+	inline DualQuat::DualQuat( const Mat4& mat ) : Real( mat )
+	{
+		Dual = Quat( mat.m[12], mat.m[13], mat.m[14], 0.0f ) * Real * 0.5f;
+	}
+
+	inline const DualQuat DualQuat::operator*( const DualQuat& dq ) const
+	{
+		// Real * dq.Real + e * ( Real * dq.Dual + Dual * dq.Real ), since e * e = 0
+		DualQuat res;
+		Internal::column dual = Internal::quatProduct( &Real.X, &dq.Dual.X );
+		Internal::store( &res.Dual.X, Internal::quatProductAdd( dual, &Dual.X, &dq.Real.X ) );
+		Internal::store( &res.Real.X, Internal::quatProduct( &Real.X, &dq.Real.X ) );
+		return res;
+	}
+
+	inline DualQuat& DualQuat::operator*=( const DualQuat& dq )
+	{
+		return *this = *this * dq;
+	}
+
+	inline const Vec3 DualQuat::operator*( const Vec3& v ) const
+	{
+		return Real * v + Translation();
+	}
+
+	inline DualQuat DualQuat::Normal() const
+	{
+		float n = 1.0f / Real.Length();
+		return DualQuat( Real * n, Dual * n );
+	}
+
+	inline OOGL_CONSTEXPR DualQuat DualQuat::Conjugate() const
+	{
+		return DualQuat( Real.Conjugate(), Dual.Conjugate() );
+	}
+
+	inline const Quat& DualQuat::Rotation() const
+	{
+		return Real;
+	}
+
+	inline Vec3 DualQuat::Translation() const
+	{
+		// The vector part of 2 * Dual * Real.Conjugate()
+		const Quat& r = Real;
+		const Quat& d = Dual;
+
+		return Vec3(
+			2.0f * ( -d.W * r.X + d.X * r.W - d.Y * r.Z + d.Z * r.Y ),
+			2.0f * ( -d.W * r.Y + d.X * r.Z + d.Y * r.W - d.Z * r.X ),
+			2.0f * ( -d.W * r.Z - d.X * r.Y + d.Y * r.X + d.Z * r.W )
+		);
+	}
+
+	inline Mat4 DualQuat::ToMat4() const
+	{
+		Mat4 res = Real.ToMat4();
+		Vec3 t = Translation();
+
+		res.m[12] = t.X;
+		res.m[13] = t.Y;
+		res.m[14] = t.Z;
+
+		return res;
+	}
+
+	inline DualQuat DualQuat::Blend( const DualQuat* dq, const float* weights, size_t count )
+	{
+		if ( count == 0 ) return DualQuat();
+
+		Quat real( 0.0f, 0.0f, 0.0f, 0.0f ), dual( 0.0f, 0.0f, 0.0f, 0.0f );
+
+		for ( size_t i = 0; i < count; i++ )
+		{
+			float w = dq[0].Real.Dot( dq[i].Real ) < 0.0f ? -weights[i] : weights[i];
+			real = real + dq[i].Real * w;
+			dual = dual + dq[i].Dual * w;
+		}
+
+		return DualQuat( real, dual ).Normal();
+	}
+
+	inline void DualQuat::Multiply( const DualQuat* a, const DualQuat* b, DualQuat* out, size_t count )
+	{
+		for ( size_t i = 0; i < count; i++ )
+			out[i] = a[i] * b[i];
+	}
+
+	inline void DualQuat::ToMat4( const DualQuat* dq, Mat4* out, size_t count )
+	{
+		for ( size_t i = 0; i < count; i++ )
+			out[i] = dq[i].ToMat4();
+	}
+}
+
+#endif
\ No newline at end of file
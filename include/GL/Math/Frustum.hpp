@@ -0,0 +1,292 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_FRUSTUM_HPP
+#define OOGL_FRUSTUM_HPP
+
+#include <GL/Math/Plane.hpp>
+#include <GL/Math/AABB.hpp>
+#include <GL/Math/Sphere.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <cstddef>
+
+namespace GL
+{
+	/*
+		View frustum as six planes with normals pointing inwards
+	*/
+	class Frustum
+	{
+	public:
+		Frustum();
+
+		// Extracts the planes from a projection or view-projection matrix, the
+		// resulting frustum is in the space the matrix transforms from
+		Frustum( const Mat4& mat );
+
+		bool Contains( const Vec3& v ) const;
+		bool Contains( const AABB& box ) const;
+
+		// Conservative tests, which may report shapes near the corners of the frustum as intersecting
+		bool Intersects( const AABB& box ) const;
+		bool Intersects( const Sphere& sphere ) const;
+
+		// Batch versions of Intersects, which write the indices of the visible
+		// shapes to visible and return how many there are. Shapes are tested four
+		// at a time. Indices may be written before they are known to be visible,
+		// so visible must have room for count entries, even if few shapes pass,
+		// and entries past the returned count are overwritten. The optional
+		// plane cache holds ( count + 3 ) / 4 zero initialized bytes, one per
+		// group of four shapes, with the plane that culled the whole group last
+		// time. That plane is tried first, which pays off when shapes that are
+		// close together are stored next to each other.
+		size_t Cull( const AABB* boxes, size_t count, size_t* visible, unsigned char* planeCache = NULL ) const;
+		size_t Cull( const Sphere* spheres, size_t count, size_t* visible, unsigned char* planeCache = NULL ) const;
+
+		enum { Left, Right, Bottom, Top, Near, Far };
+		Plane Planes[6];
+
+	private:
+		template < typename Columns, typename Shape >
+		size_t cull( const Shape* shapes, size_t count, size_t* visible, unsigned char* planeCache ) const;
+
+		template < typename Columns, typename Shape >
+		size_t cullGroup( const Shape* group, size_t first, size_t count, size_t* visible, unsigned char* planeCache ) const;
+	};
+
+	namespace Internal
+	{
+		/*
+			Four shapes with every coordinate in its own column, so they are
+			tested against a plane at once. The distances are computed in the same
+			order as Plane::Distance, so the results match the single shape tests.
+		*/
+
+#if defined( OOGL_SIMD_SSE2 )
+		inline column add( column c, float s ) { return _mm_add_ps( c, _mm_set1_ps( s ) ); }
+		inline int lessMask( column a, column b ) { return _mm_movemask_ps( _mm_cmplt_ps( a, b ) ); }
+#elif defined( OOGL_SIMD_NEON )
+		inline column add( column c, float s ) { return vaddq_f32( c, vdupq_n_f32( s ) ); }
+		inline int lessMask( column a, column b )
+		{
+			uint32x4_t m = vcltq_f32( a, b );
+			return ( vgetq_lane_u32( m, 0 ) & 1 ) | ( vgetq_lane_u32( m, 1 ) & 2 ) | ( vgetq_lane_u32( m, 2 ) & 4 ) | ( vgetq_lane_u32( m, 3 ) & 8 );
+		}
+#else
+		inline column add( column c, float s ) { column r = { { c.v[0] + s, c.v[1] + s, c.v[2] + s, c.v[3] + s } }; return r; }
+		inline int lessMask( column a, column b )
+		{
+			int mask = 0;
+			for ( int i = 0; i < 4; i++ )
+				mask |= ( a.v[i] < b.v[i] ) << i;
+			return mask;
+		}
+#endif
+
+		struct boxColumns
+		{
+			column lo[3], hi[3];
+		};
+
+		struct sphereColumns
+		{
+			column center[3], negRadius;
+		};
+
+		inline void loadShapes( const AABB* boxes, boxColumns& c )
+		{
+			// A box is six consecutive floats, so the loads starting at Min.X and
+			// Min.Z together contain all of them
+			column a[4] = { load( &boxes[0].Min.X ), load( &boxes[1].Min.X ), load( &boxes[2].Min.X ), load( &boxes[3].Min.X ) };
+			column b[4] = { load( &boxes[0].Min.Z ), load( &boxes[1].Min.Z ), load( &boxes[2].Min.Z ), load( &boxes[3].Min.Z ) };
+			transposeColumns( a );
+			transposeColumns( b );
+
+			for ( int i = 0; i < 3; i++ )
+			{
+				c.lo[i] = a[i];
+				c.hi[i] = b[i + 1];
+			}
+		}
+
+		inline void loadShapes( const Sphere* spheres, sphereColumns& c )
+		{
+			column a[4] = { load( &spheres[0].Center.X ), load( &spheres[1].Center.X ), load( &spheres[2].Center.X ), load( &spheres[3].Center.X ) };
+			transposeColumns( a );
+
+			for ( int i = 0; i < 3; i++ )
+				c.center[i] = a[i];
+			c.negRadius = mul( a[3], -1.0f );
+		}
+
+		// Bit i is set if shape i is completely on the negative side of the plane
+		inline int outsideMask( const boxColumns& c, const Plane& plane )
+		{
+			// Corners furthest along the normal, like Frustum::Intersects
+			const Vec3& n = plane.Normal;
+			const column& x = n.X >= 0.0f ? c.hi[0] : c.lo[0];
+			const column& y = n.Y >= 0.0f ? c.hi[1] : c.lo[1];
+			const column& z = n.Z >= 0.0f ? c.hi[2] : c.lo[2];
+			column d = madd( madd( mul( x, n.X ), y, n.Y ), z, n.Z );
+			return lessMask( add( d, plane.D ), set( 0.0f, 0.0f, 0.0f, 0.0f ) );
+		}
+
+		inline int outsideMask( const sphereColumns& c, const Plane& plane )
+		{
+			const Vec3& n = plane.Normal;
+			column d = madd( madd( mul( c.center[0], n.X ), c.center[1], n.Y ), c.center[2], n.Z );
+			return lessMask( add( d, plane.D ), c.negRadius );
+		}
+	}
+
+	inline Frustum::Frustum()
+	{
+	}
+
+	inline Frustum::Frustum( const Mat4& mat )
+	{
+		// Every plane is the sum or difference of the last row and one of the others
+		const float* m = mat.m;
+		Vec3 w( m[3], m[7], m[11] );
+
+		for ( int i = 0; i < 3; i++ )
+		{
+			Vec3 row( m[i], m[4+i], m[8+i] );
+			Planes[i*2] = Plane( w + row, m[15] + m[12+i] ).Normalize();
+			Planes[i*2+1] = Plane( w - row, m[15] - m[12+i] ).Normalize();
+		}
+	}
+
+	inline bool Frustum::Contains( const Vec3& v ) const
+	{
+		for ( int i = 0; i < 6; i++ )
+			if ( Planes[i].Distance( v ) < 0.0f ) return false;
+		return true;
+	}
+
+	inline bool Frustum::Contains( const AABB& box ) const
+	{
+		// The corner furthest against the normal has to be inside every plane
+		for ( int i = 0; i < 6; i++ )
+		{
+			const Vec3& n = Planes[i].Normal;
+			Vec3 p( n.X >= 0.0f ? box.Min.X : box.Max.X, n.Y >= 0.0f ? box.Min.Y : box.Max.Y, n.Z >= 0.0f ? box.Min.Z : box.Max.Z );
+			if ( Planes[i].Distance( p ) < 0.0f ) return false;
+		}
+		return true;
+	}
+
+	inline bool Frustum::Intersects( const AABB& box ) const
+	{
+		// The box is outside if the corner furthest along the normal is outside any plane
+		for ( int i = 0; i < 6; i++ )
+		{
+			const Vec3& n = Planes[i].Normal;
+			Vec3 p( n.X >= 0.0f ? box.Max.X : box.Min.X, n.Y >= 0.0f ? box.Max.Y : box.Min.Y, n.Z >= 0.0f ? box.Max.Z : box.Min.Z );
+			if ( Planes[i].Distance( p ) < 0.0f ) return false;
+		}
+		return true;
+	}
+
+	inline bool Frustum::Intersects( const Sphere& sphere ) const
+	{
+		for ( int i = 0; i < 6; i++ )
+			if ( Planes[i].Distance( sphere.Center ) < -sphere.Radius ) return false;
+		return true;
+	}
+
+	inline size_t Frustum::Cull( const AABB* boxes, size_t count, size_t* visible, unsigned char* planeCache ) const
+	{
+		return cull<Internal::boxColumns>( boxes, count, visible, planeCache );
+	}
+
+	inline size_t Frustum::Cull( const Sphere* spheres, size_t count, size_t* visible, unsigned char* planeCache ) const
+	{
+		return cull<Internal::sphereColumns>( spheres, count, visible, planeCache );
+	}
+
+	template < typename Columns, typename Shape >
+	inline size_t Frustum::cull( const Shape* shapes, size_t count, size_t* visible, unsigned char* planeCache ) const
+	{
+		size_t visibleCount = 0, i = 0;
+
+#if !defined( OOGL_SIMD_SSE2 ) && !defined( OOGL_SIMD_NEON )
+		// Without SIMD testing all planes for four shapes at once is slower than
+		// stopping at the first plane that culls a shape, so the cache is unused
+		( void )planeCache;
+		for ( ; i < count; i++ )
+		{
+			visible[visibleCount] = i;
+			visibleCount += Intersects( shapes[i] );
+		}
+#else
+		for ( ; i + 4 <= count; i += 4 )
+			visibleCount += cullGroup<Columns>( shapes + i, i, 4, visible + visibleCount, planeCache ? planeCache + i / 4 : NULL );
+
+		// The last group is padded with copies of its first shape
+		if ( i < count ) {
+			Shape group[4];
+			for ( size_t k = 0; k < 4; k++ )
+				group[k] = shapes[i + ( i + k < count ? k : 0 )];
+			visibleCount += cullGroup<Columns>( group, i, count - i, visible + visibleCount, planeCache ? planeCache + i / 4 : NULL );
+		}
+#endif
+
+		return visibleCount;
+	}
+
+	template < typename Columns, typename Shape >
+	inline size_t Frustum::cullGroup( const Shape* group, size_t first, size_t count, size_t* visible, unsigned char* planeCache ) const
+	{
+		Columns c;
+		Internal::loadShapes( group, c );
+
+		// A plane that culled the whole group last time most likely still does
+		int cached = planeCache ? *planeCache : 0;
+		if ( planeCache && Internal::outsideMask( c, Planes[cached] ) == 15 ) return 0;
+
+		// Testing every plane is faster than stopping early, which mispredicts a lot
+		int outside = 0;
+		for ( int i = 0; i < 6; i++ )
+		{
+			int culled = Internal::outsideMask( c, Planes[i] );
+			outside |= culled;
+			cached = culled == 15 ? i : cached;
+		}
+
+		if ( planeCache ) *planeCache = (unsigned char)cached;
+
+		// Append the visible indices without branching on every shape
+		int inside = ~outside & ( ( 1 << count ) - 1 );
+		size_t visibleCount = 0;
+		for ( size_t k = 0; k < count; k++ )
+		{
+			visible[visibleCount] = first + k;
+			visibleCount += ( inside >> k ) & 1;
+		}
+
+		return visibleCount;
+	}
+}
+
+#endif
\ No newline at end of file
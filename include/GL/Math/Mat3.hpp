@@ -24,7 +24,9 @@
 #ifndef OOGL_MAT3_HPP
 #define OOGL_MAT3_HPP
 
+#include <GL/Math/Util.hpp>
 #include <GL/Math/Vec2.hpp>
+#include <cmath>
 
 namespace GL
 {
@@ -34,8 +36,8 @@ namespace GL
 	class Mat3
 	{
 	public:
-		Mat3();
-		Mat3(
+		OOGL_CONSTEXPR Mat3();
+		OOGL_CONSTEXPR Mat3(
 			float v00, float v01, float v02,
 			float v10, float v11, float v12,
 			float v20, float v21, float v22
@@ -55,6 +57,114 @@ namespace GL
 		
 		float m[9];
 	};
+
+	inline OOGL_CONSTEXPR Mat3::Mat3()
+		: m{
+			1, 0, 0,
+			0, 1, 0,
+			0, 0, 1
+		}
+	{
+	}
+
+	// The elements are given row by row and stored column by column
+	inline OOGL_CONSTEXPR Mat3::Mat3( float v00, float v01, float v02, float v10, float v11, float v12, float v20, float v21, float v22 )
+		: m{
+			v00, v10, v20,
+			v01, v11, v21,
+			v02, v12, v22
+		}
+	{
+	}
+
+	inline const Mat3 Mat3::operator*( const Mat3& mat )
+	{
+		return Mat3(
+			mat.m[0]*m[0]+mat.m[1]*m[3]+mat.m[2]*m[6], mat.m[3]*m[0]+mat.m[4]*m[3]+mat.m[5]*m[6], mat.m[6]*m[0]+mat.m[7]*m[3]+mat.m[8]*m[6],
+			mat.m[0]*m[1]+mat.m[1]*m[4]+mat.m[2]*m[7], mat.m[3]*m[1]+mat.m[4]*m[4]+mat.m[5]*m[7], mat.m[6]*m[1]+mat.m[7]*m[4]+mat.m[8]*m[7],
+			mat.m[0]*m[2]+mat.m[1]*m[5]+mat.m[2]*m[8], mat.m[3]*m[2]+mat.m[4]*m[5]+mat.m[5]*m[8], mat.m[6]*m[2]+mat.m[7]*m[5]+mat.m[8]*m[8]
+		);
+	}
+
+	inline const Vec2 Mat3::operator*( const Vec2& v )
+	{
+		return Vec2(
+			m[0]*v.X + m[3]*v.Y + m[6],
+			m[1]*v.X + m[4]*v.Y + m[7]
+		);
+	}
+
+	inline Mat3& Mat3::Translate( const Vec2& v )
+	{
+		return *this = *this * Mat3(
+			1, 0, v.X,
+			0, 1, v.Y,
+			0, 0, 1
+		);
+	}
+
+	inline Mat3& Mat3::Scale( const Vec2& v )
+	{
+		return *this = *this * Mat3(
+			v.X, 0, 0,
+			0, v.Y, 0,
+			0, 0, 1
+		);
+	}
+
+	inline Mat3& Mat3::Rotation( float ang )
+	{
+		float s, c;
+		Internal::sinCos( ang, s, c );
+		return *this = *this * Mat3(
+			c, -s, 0,
+			s, c, 0,
+			0, 0, 1
+		);
+	}
+
+	inline Mat3 Mat3::Transpose() const
+	{
+		Mat3 res;
+
+		res.m[0] = m[0];
+		res.m[1] = m[3];
+		res.m[2] = m[6];
+
+		res.m[3] = m[1];
+		res.m[4] = m[4];
+		res.m[5] = m[7];
+
+		res.m[6] = m[2];
+		res.m[7] = m[5];
+		res.m[8] = m[8];
+
+		return res;
+	}
+
+	inline float Mat3::Determinant() const
+	{
+		return m[0] * ( m[8] * m[4] - m[5] * m[7] ) + m[1] * ( -m[8] * m[3] + m[5] * m[6] ) + m[2] * ( m[7] * m[3] - m[4] * m[6] );
+	}
+
+	inline Mat3 Mat3::Inverse() const
+	{
+		float det = Determinant();
+
+		Mat3 res;
+
+		res.m[0] = ( m[8] * m[4] - m[5] * m[7] ) / det;
+        res.m[1] = ( -m[8] * m[1] + m[2] * m[7] ) / det;
+        res.m[2] = ( m[5] * m[1] - m[2] * m[4] ) / det;
+        res.m[3] = ( -m[8] * m[3] + m[5] * m[6] ) / det;
+        res.m[4] = ( m[8] * m[0] - m[2] * m[6] ) / det;
+        res.m[5] = ( -m[5] * m[0] + m[2] * m[3] ) / det;
+        res.m[6] = ( m[7] * m[3] - m[4] * m[6] ) / det;
+        res.m[7] = ( -m[7] * m[0] + m[1] * m[6] ) / det;
+        res.m[8] = ( m[4] * m[0] - m[1] * m[3] ) / det;
+
+		return res;
+	}
 }
 
 #endif
\ No newline at end of file
@@ -24,8 +24,19 @@
 #ifndef OOGL_MAT4_HPP
 #define OOGL_MAT4_HPP
 
+#include <GL/SIMD.hpp>
+#include <GL/Math/Util.hpp>
 #include <GL/Math/Vec3.hpp>
 #include <GL/Math/Vec4.hpp>
+#include <GL/Math/Mat3.hpp>
+#include <cstddef>
+#include <cmath>
+
+#if defined( OOGL_SIMD_SSE2 )
+	#include <emmintrin.h>
+#elif defined( OOGL_SIMD_NEON )
+	#include <arm_neon.h>
+#endif
 
 namespace GL
 {
@@ -35,8 +46,8 @@ namespace GL
 	class Mat4
 	{
 	public:
-		Mat4();
-		Mat4(
+		OOGL_CONSTEXPR Mat4();
+		OOGL_CONSTEXPR Mat4(
 			float v00, float v01, float v02, float v03,
 			float v10, float v11, float v12, float v13,
 			float v20, float v21, float v22, float v23,
@@ -47,6 +58,12 @@ namespace GL
 		const Vec3 operator*( const Vec3& v ) const;
 		const Vec4 operator*( const Vec4& v ) const;
 
+		// Transform count points (W = 1), directions (W = 0) or vectors at once,
+		// in and out may be the same array
+		void TransformPoints( const Vec3* in, Vec3* out, size_t count ) const;
+		void TransformDirections( const Vec3* in, Vec3* out, size_t count ) const;
+		void Transform( const Vec4* in, Vec4* out, size_t count ) const;
+
 		Mat4& Translate( const Vec3& v );
 		Mat4& Scale( const Vec3& v );
 
@@ -57,22 +74,584 @@ namespace GL
 
 		Mat4 Transpose() const;
 
+		// Inverses of matrices with 0, 0, 0, 1 as bottom row, which Inverse() also
+		// detects. RigidInverse only handles rotations and translations.
+		bool IsAffine() const;
+		Mat4 AffineInverse() const;
+		Mat4 RigidInverse() const;
+
+		// Inverse transpose of the upper 3-by-3 part, which transforms normals
+		Mat3 NormalMatrix() const;
+
 		// The implementations of the functions below are based on the awesome
 		// glMatrix library developed by Brandon Jones and Colin MacKenzie IV
 
 		float Determinant() const;
 		Mat4 Inverse() const;
 
-		static Mat4 Frustum( float left, float right, float bottom, float top, float near, float far );
-		static Mat4 Perspective( float fovy, float aspect, float near, float far );
-		static Mat4 Ortho( float left, float right, float bottom, float top, float near, float far );
+		static Mat4 Frustum( float left, float right, float bottom, float top, float zNear, float zFar );
+		static Mat4 Perspective( float fovy, float aspect, float zNear, float zFar );
+		static Mat4 Ortho( float left, float right, float bottom, float top, float zNear, float zFar );
 		static Mat4 LookAt( const Vec3& eye, const Vec3& center, const Vec3& up );
 
 		static Vec3 UnProject( const Vec3& vec, const Mat4& view, const Mat4& proj, const float viewport[] );
 		static Vec3 Project( const Vec3& vec, const Mat4& view, const Mat4& proj, const float viewport[] );
 		
 		float m[16];
+
+	private:
+		Mat4 cofactorInverse() const;
 	};
+
+	namespace Internal
+	{
+		/*
+			Column arithmetic
+
+			Matrices are stored column by column, so a product is built from whole
+			columns scaled by single elements. The sums are accumulated in the same
+			order on every instruction set, which makes the results identical to
+			the scalar code.
+		*/
+
+#if defined( OOGL_SIMD_SSE2 )
+		typedef __m128 column;
+
+		inline column load( const float* p ) { return _mm_loadu_ps( p ); }
+		inline column set( float x, float y, float z, float w ) { return _mm_setr_ps( x, y, z, w ); }
+		inline void store( float* p, column c ) { _mm_storeu_ps( p, c ); }
+		inline column mul( column c, float s ) { return _mm_mul_ps( c, _mm_set1_ps( s ) ); }
+		inline column madd( column acc, column c, float s ) { return _mm_add_ps( acc, _mm_mul_ps( c, _mm_set1_ps( s ) ) ); }
+#elif defined( OOGL_SIMD_NEON )
+		typedef float32x4_t column;
+
+		inline column load( const float* p ) { return vld1q_f32( p ); }
+		inline column set( float x, float y, float z, float w ) { const float v[4] = { x, y, z, w }; return vld1q_f32( v ); }
+		inline void store( float* p, column c ) { vst1q_f32( p, c ); }
+		inline column mul( column c, float s ) { return vmulq_n_f32( c, s ); }
+		inline column madd( column acc, column c, float s ) { return vmlaq_n_f32( acc, c, s ); }
+#else
+		struct column
+		{
+			float v[4];
+		};
+
+		inline column load( const float* p ) { column c = { { p[0], p[1], p[2], p[3] } }; return c; }
+		inline column set( float x, float y, float z, float w ) { column c = { { x, y, z, w } }; return c; }
+		inline void store( float* p, column c ) { p[0] = c.v[0]; p[1] = c.v[1]; p[2] = c.v[2]; p[3] = c.v[3]; }
+		inline column mul( column c, float s ) { column r = { { c.v[0] * s, c.v[1] * s, c.v[2] * s, c.v[3] * s } }; return r; }
+		inline column madd( column acc, column c, float s ) { column r = { { acc.v[0] + c.v[0] * s, acc.v[1] + c.v[1] * s, acc.v[2] + c.v[2] * s, acc.v[3] + c.v[3] * s } }; return r; }
+#endif
+
+		// Loads the four columns of m
+		inline void loadColumns( const float* m, column a[4] )
+		{
+			a[0] = load( m );
+			a[1] = load( m + 4 );
+			a[2] = load( m + 8 );
+			a[3] = load( m + 12 );
+		}
+
+		// The columns a[0] to a[3] combined with the weights x, y, z and w
+		inline column combine( const column a[4], float x, float y, float z, float w )
+		{
+			return madd( madd( madd( mul( a[0], x ), a[1], y ), a[2], z ), a[3], w );
+		}
+
+		// The same with the weights in memory, which should not have been written
+		// as single floats right before, or the load has to wait for the stores
+		inline column combine( const column a[4], const float* v )
+		{
+#if defined( OOGL_SIMD_SSE2 )
+			// One load and a shuffle per weight instead of a load and a broadcast each
+			__m128 w = _mm_loadu_ps( v );
+			__m128 r = _mm_mul_ps( a[0], _mm_shuffle_ps( w, w, _MM_SHUFFLE( 0, 0, 0, 0 ) ) );
+			r = _mm_add_ps( r, _mm_mul_ps( a[1], _mm_shuffle_ps( w, w, _MM_SHUFFLE( 1, 1, 1, 1 ) ) ) );
+			r = _mm_add_ps( r, _mm_mul_ps( a[2], _mm_shuffle_ps( w, w, _MM_SHUFFLE( 2, 2, 2, 2 ) ) ) );
+			return _mm_add_ps( r, _mm_mul_ps( a[3], _mm_shuffle_ps( w, w, _MM_SHUFFLE( 3, 3, 3, 3 ) ) ) );
+#else
+			return combine( a, v[0], v[1], v[2], v[3] );
+#endif
+		}
+
+		// Multiplies by a rotation that only mixes columns i and j
+		inline void rotateColumns( float* m, int i, int j, float c, float s )
+		{
+			column a = load( m + i * 4 ), b = load( m + j * 4 );
+			store( m + i * 4, madd( mul( a, c ), b, s ) );
+			store( m + j * 4, madd( mul( a, -s ), b, c ) );
+		}
+
+		// Transposes the matrix with the columns a[0] to a[3]
+		inline void transposeColumns( column a[4] )
+		{
+#if defined( OOGL_SIMD_SSE2 )
+			_MM_TRANSPOSE4_PS( a[0], a[1], a[2], a[3] );
+#elif defined( OOGL_SIMD_NEON )
+			float32x4x2_t t0 = vtrnq_f32( a[0], a[1] ), t1 = vtrnq_f32( a[2], a[3] );
+			a[0] = vcombine_f32( vget_low_f32( t0.val[0] ), vget_low_f32( t1.val[0] ) );
+			a[1] = vcombine_f32( vget_low_f32( t0.val[1] ), vget_low_f32( t1.val[1] ) );
+			a[2] = vcombine_f32( vget_high_f32( t0.val[0] ), vget_high_f32( t1.val[0] ) );
+			a[3] = vcombine_f32( vget_high_f32( t0.val[1] ), vget_high_f32( t1.val[1] ) );
+#else
+			for ( int i = 0; i < 4; i++ )
+				for ( int j = i + 1; j < 4; j++ )
+				{
+					float t = a[i].v[j];
+					a[i].v[j] = a[j].v[i];
+					a[j].v[i] = t;
+				}
+#endif
+		}
+
+		// Replaces the first three columns with their combinations by the 3x3 matrix r,
+		// which is stored column by column like Mat4, for multiplying by a rotation
+		inline void combineLinear( float* m, const float r[9] )
+		{
+			column a[3] = { load( m ), load( m + 4 ), load( m + 8 ) };
+			for ( int j = 0; j < 3; j++ )
+				store( m + j * 4, madd( madd( mul( a[0], r[j * 3] ), a[1], r[j * 3 + 1] ), a[2], r[j * 3 + 2] ) );
+		}
+
+		// Transforms count vectors of three floats by the linear part of m and adds t
+		inline void transformVec3( const float* m, const float t[3], const float* src, float* dst, size_t count )
+		{
+			size_t i = 0;
+
+#if defined( OOGL_SIMD_SSE2 )
+			// Four points are transposed into an X, Y and Z register. The first three
+			// are loaded and stored with the X of the next point, which is stored
+			// again right after with its own value.
+			for ( ; i + 4 <= count; i += 4, src += 12, dst += 12 )
+			{
+				__m128 p0 = _mm_loadu_ps( src );
+				__m128 p1 = _mm_loadu_ps( src + 3 );
+				__m128 p2 = _mm_loadu_ps( src + 6 );
+				__m128 p3 = _mm_movelh_ps( _mm_loadl_pi( _mm_setzero_ps(), (const __m64*)( src + 9 ) ), _mm_load_ss( src + 11 ) );
+				_MM_TRANSPOSE4_PS( p0, p1, p2, p3 );
+
+				// Each row of the result is a dot product with a row of the matrix
+				__m128 r[3];
+				for ( int k = 0; k < 3; k++ )
+				{
+					__m128 x = _mm_mul_ps( p0, _mm_set1_ps( m[k] ) );
+					x = _mm_add_ps( x, _mm_mul_ps( p1, _mm_set1_ps( m[k + 4] ) ) );
+					x = _mm_add_ps( x, _mm_mul_ps( p2, _mm_set1_ps( m[k + 8] ) ) );
+					r[k] = _mm_add_ps( x, _mm_set1_ps( t[k] ) );
+				}
+
+				__m128 r3 = _mm_setzero_ps();
+				_MM_TRANSPOSE4_PS( r[0], r[1], r[2], r3 );
+				_mm_storeu_ps( dst, r[0] );
+				_mm_storeu_ps( dst + 3, r[1] );
+				_mm_storeu_ps( dst + 6, r[2] );
+				_mm_storel_pi( (__m64*)( dst + 9 ), r3 );
+				_mm_store_ss( dst + 11, _mm_movehl_ps( r3, r3 ) );
+			}
+#elif defined( OOGL_SIMD_NEON )
+			for ( ; i + 4 <= count; i += 4, src += 12, dst += 12 )
+			{
+				float32x4x3_t p = vld3q_f32( src ), r;
+				for ( int k = 0; k < 3; k++ )
+				{
+					float32x4_t x = vmulq_n_f32( p.val[0], m[k] );
+					x = vmlaq_n_f32( x, p.val[1], m[k + 4] );
+					x = vmlaq_n_f32( x, p.val[2], m[k + 8] );
+					r.val[k] = vaddq_f32( x, vdupq_n_f32( t[k] ) );
+				}
+				vst3q_f32( dst, r );
+			}
+#endif
+
+			for ( ; i < count; i++, src += 3, dst += 3 )
+			{
+				float x = src[0], y = src[1], z = src[2];
+				dst[0] = m[0]*x + m[4]*y + m[8]*z + t[0];
+				dst[1] = m[1]*x + m[5]*y + m[9]*z + t[1];
+				dst[2] = m[2]*x + m[6]*y + m[10]*z + t[2];
+			}
+		}
+	}
+
+	inline OOGL_CONSTEXPR Mat4::Mat4()
+		: m{
+			1, 0, 0, 0,
+			0, 1, 0, 0,
+			0, 0, 1, 0,
+			0, 0, 0, 1
+		}
+	{
+	}
+
+	// The elements are given row by row and stored column by column
+	inline OOGL_CONSTEXPR Mat4::Mat4( float v00, float v01, float v02, float v03, float v10, float v11, float v12, float v13, float v20, float v21, float v22, float v23, float v30, float v31, float v32, float v33 )
+		: m{
+			v00, v10, v20, v30,
+			v01, v11, v21, v31,
+			v02, v12, v22, v32,
+			v03, v13, v23, v33
+		}
+	{
+	}
+
+	inline const Mat4 Mat4::operator*( const Mat4& mat ) const
+	{
+		Mat4 res;
+
+		// Unrolled by hand, a loop over the columns is left rolled and keeps the
+		// result on the stack
+		Internal::column a[4];
+		Internal::loadColumns( m, a );
+		Internal::store( res.m, Internal::combine( a, mat.m ) );
+		Internal::store( res.m + 4, Internal::combine( a, mat.m + 4 ) );
+		Internal::store( res.m + 8, Internal::combine( a, mat.m + 8 ) );
+		Internal::store( res.m + 12, Internal::combine( a, mat.m + 12 ) );
+
+		return res;
+	}
+
+	inline const Vec3 Mat4::operator*( const Vec3& v ) const
+	{
+		return Vec3(
+			m[0]*v.X + m[4]*v.Y + m[8]*v.Z + m[12],
+			m[1]*v.X + m[5]*v.Y + m[9]*v.Z + m[13],
+			m[2]*v.X + m[6]*v.Y + m[10]*v.Z + m[14]
+		);
+	}
+
+	inline const Vec4 Mat4::operator*( const Vec4& v ) const
+	{
+		Internal::column a[4];
+		Internal::loadColumns( m, a );
+		float out[4];
+		Internal::store( out, Internal::combine( a, v.X, v.Y, v.Z, v.W ) );
+
+		return Vec4( out[0], out[1], out[2], out[3] );
+	}
+
+	inline void Mat4::TransformPoints( const Vec3* in, Vec3* out, size_t count ) const
+	{
+		const float t[3] = { m[12], m[13], m[14] };
+		Internal::transformVec3( m, t, (const float*)in, (float*)out, count );
+	}
+
+	inline void Mat4::TransformDirections( const Vec3* in, Vec3* out, size_t count ) const
+	{
+		const float t[3] = { 0, 0, 0 };
+		Internal::transformVec3( m, t, (const float*)in, (float*)out, count );
+	}
+
+	inline void Mat4::Transform( const Vec4* in, Vec4* out, size_t count ) const
+	{
+		Internal::column a[4];
+		Internal::loadColumns( m, a );
+		for ( size_t i = 0; i < count; i++ )
+			Internal::store( (float*)( out + i ), Internal::combine( a, (const float*)( in + i ) ) );
+	}
+
+	// Multiplying by a translation, scale or rotation only changes some of the
+	// columns, which is done directly instead of with a full product
+
+	inline Mat4& Mat4::Translate( const Vec3& v )
+	{
+		Internal::column a[4];
+		Internal::loadColumns( m, a );
+		Internal::store( m + 12, Internal::combine( a, v.X, v.Y, v.Z, 1.0f ) );
+		return *this;
+	}
+
+	inline Mat4& Mat4::Scale( const Vec3& v )
+	{
+		Internal::store( m, Internal::mul( Internal::load( m ), v.X ) );
+		Internal::store( m + 4, Internal::mul( Internal::load( m + 4 ), v.Y ) );
+		Internal::store( m + 8, Internal::mul( Internal::load( m + 8 ), v.Z ) );
+		return *this;
+	}
+
+	inline Mat4& Mat4::RotateX( float ang )
+	{
+		float s, c;
+		Internal::sinCos( ang, s, c );
+		Internal::rotateColumns( m, 1, 2, c, s );
+		return *this;
+	}
+
+	inline Mat4& Mat4::RotateY( float ang )
+	{
+		float s, c;
+		Internal::sinCos( ang, s, c );
+		Internal::rotateColumns( m, 2, 0, c, s );
+		return *this;
+	}
+
+	inline Mat4& Mat4::RotateZ( float ang )
+	{
+		float s, c;
+		Internal::sinCos( ang, s, c );
+		Internal::rotateColumns( m, 0, 1, c, s );
+		return *this;
+	}
+
+	inline Mat4& Mat4::Rotate( const Vec3& axis, float ang )
+	{
+		float s, c;
+		Internal::sinCos( ang, s, c );
+		float t = 1 - c;
+		Vec3 a = axis.Normal();
+
+		const float r[9] = {
+			a.X * a.X * t + c, a.Y * a.X * t + a.Z * s, a.Z * a.X * t - a.Y * s,
+			a.X * a.Y * t - a.Z * s, a.Y * a.Y * t + c, a.Z * a.Y * t + a.X * s,
+			a.X * a.Z * t + a.Y * s, a.Y * a.Z * t - a.X * s, a.Z * a.Z * t + c
+		};
+		Internal::combineLinear( m, r );
+		return *this;
+	}
+
+	inline Mat4 Mat4::Transpose() const
+	{
+		Mat4 res;
+
+		res.m[0] = m[0];
+		res.m[1] = m[4];
+		res.m[2] = m[8];
+		res.m[3] = m[12];
+
+		res.m[4] = m[1];
+		res.m[5] = m[5];
+		res.m[6] = m[9];
+		res.m[7] = m[13];
+
+		res.m[8] = m[2];
+		res.m[9] = m[6];
+		res.m[10] = m[10];
+		res.m[11] = m[14];
+
+		res.m[12] = m[3];
+		res.m[13] = m[7];
+		res.m[14] = m[11];
+		res.m[15] = m[15];
+
+		return res;
+	}
+
+	inline bool Mat4::IsAffine() const
+	{
+		return m[3] == 0.0f && m[7] == 0.0f && m[11] == 0.0f && m[15] == 1.0f;
+	}
+
+	inline Mat4 Mat4::AffineInverse() const
+	{
+		// The rows of the inverse 3-by-3 part are the cross products of its
+		// columns divided by the determinant, the inverse then rotates the
+		// negated translation
+		Vec3 c0( m[0], m[1], m[2] ), c1( m[4], m[5], m[6] ), c2( m[8], m[9], m[10] );
+		Vec3 r0 = c1.Cross( c2 ), r1 = c2.Cross( c0 ), r2 = c0.Cross( c1 );
+		float invDet = 1.0f / c0.Dot( r0 );
+
+		Mat4 res;
+		Internal::column a[4] = {
+			Internal::mul( Internal::set( r0.X, r1.X, r2.X, 0.0f ), invDet ),
+			Internal::mul( Internal::set( r0.Y, r1.Y, r2.Y, 0.0f ), invDet ),
+			Internal::mul( Internal::set( r0.Z, r1.Z, r2.Z, 0.0f ), invDet ),
+			Internal::set( 0.0f, 0.0f, 0.0f, 1.0f )
+		};
+
+		Internal::store( res.m, a[0] );
+		Internal::store( res.m + 4, a[1] );
+		Internal::store( res.m + 8, a[2] );
+		Internal::store( res.m + 12, Internal::combine( a, -m[12], -m[13], -m[14], 1.0f ) );
+
+		return res;
+	}
+
+	inline Mat4 Mat4::RigidInverse() const
+	{
+		// The rotation is inverted by transposing it, which then rotates the
+		// negated translation
+		Mat4 res;
+		Internal::column a[4];
+		Internal::loadColumns( m, a );
+		a[3] = Internal::set( 0.0f, 0.0f, 0.0f, 1.0f );
+		Internal::transposeColumns( a );
+
+		Internal::store( res.m, a[0] );
+		Internal::store( res.m + 4, a[1] );
+		Internal::store( res.m + 8, a[2] );
+		Internal::store( res.m + 12, Internal::combine( a, -m[12], -m[13], -m[14], 1.0f ) );
+
+		return res;
+	}
+
+	inline Mat3 Mat4::NormalMatrix() const
+	{
+		// The transposed inverse has the cross products from AffineInverse as columns
+		Vec3 c0( m[0], m[1], m[2] ), c1( m[4], m[5], m[6] ), c2( m[8], m[9], m[10] );
+		Vec3 r0 = c1.Cross( c2 ), r1 = c2.Cross( c0 ), r2 = c0.Cross( c1 );
+		float invDet = 1.0f / c0.Dot( r0 );
+
+		return Mat3(
+			r0.X * invDet, r1.X * invDet, r2.X * invDet,
+			r0.Y * invDet, r1.Y * invDet, r2.Y * invDet,
+			r0.Z * invDet, r1.Z * invDet, r2.Z * invDet
+		);
+	}
+
+	inline float Mat4::Determinant() const
+	{
+		return m[12] * m[9] * m[6] * m[3] - m[8] * m[13] * m[6] * m[3] - m[12] * m[5] * m[10] * m[3] + m[4] * m[13] * m[10] * m[3] +
+               m[8] * m[5] * m[14] * m[3] - m[4] * m[9] * m[14] * m[3] - m[12] * m[9] * m[2] * m[7] + m[8] * m[13] * m[2] * m[7] +
+               m[12] * m[1] * m[10] * m[7] - m[0] * m[13] * m[10] * m[7] - m[8] * m[1] * m[14] * m[7] + m[0] * m[9] * m[14] * m[7] +
+               m[12] * m[5] * m[2] * m[11] - m[4] * m[13] * m[2] * m[11] - m[12] * m[1] * m[6] * m[11] + m[0] * m[13] * m[6] * m[11] +
+               m[4] * m[1] * m[14] * m[11] - m[0] * m[5] * m[14] * m[11] - m[8] * m[5] * m[2] * m[15] + m[4] * m[9] * m[2] * m[15] +
+               m[8] * m[1] * m[6] * m[15] - m[0] * m[9] * m[6] * m[15] - m[4] * m[1] * m[10] * m[15] + m[0] * m[5] * m[10] * m[15];
+	}
+
+	inline Mat4 Mat4::Inverse() const
+	{
+		return IsAffine() ? AffineInverse() : cofactorInverse();
+	}
+
+	// Out of line, inlining it into Inverse() slows down the affine case
+	OOGL_NOINLINE inline Mat4 Mat4::cofactorInverse() const
+	{
+		float det = Determinant();
+
+		Mat4 res;
+
+		float t0 = m[0] * m[5] - m[1] * m[4];
+        float t1 = m[0] * m[6] - m[2] * m[4];
+        float t2 = m[0] * m[7] - m[3] * m[4];
+        float t3 = m[1] * m[6] - m[2] * m[5];
+        float t4 = m[1] * m[7] - m[3] * m[5];
+        float t5 = m[2] * m[7] - m[3] * m[6];
+        float t6 = m[8] * m[13] - m[9] * m[12];
+        float t7 = m[8] * m[14] - m[10] * m[12];
+        float t8 = m[8] * m[15] - m[11] * m[12];
+        float t9 = m[9] * m[14] - m[10] * m[13];
+        float t10 = m[9] * m[15] - m[11] * m[13];
+        float t11 = m[10] * m[15] - m[11] * m[14];
+
+		res.m[0] = ( m[5] * t11 - m[6] * t10 + m[7] * t9 ) / det;
+        res.m[1] = ( -m[1] * t11 + m[2] * t10 - m[3] * t9 ) / det;
+        res.m[2] = ( m[13] * t5 - m[14] * t4 + m[15] * t3 ) / det;
+        res.m[3] = ( -m[9] * t5 + m[10] * t4 - m[11] * t3 ) / det;
+        res.m[4] = ( -m[4] * t11 + m[6] * t8 - m[7] * t7 ) / det;
+        res.m[5] = ( m[0] * t11 - m[2] * t8 + m[3] * t7 ) / det;
+        res.m[6] = ( -m[12] * t5 + m[14] * t2 - m[15] * t1 ) / det;
+        res.m[7] = ( m[8] * t5 - m[10] * t2 + m[11] * t1 ) / det;
+        res.m[8] = ( m[4] * t10 - m[5] * t8 + m[7] * t6 ) / det;
+        res.m[9] = ( -m[0] * t10 + m[1] * t8 - m[3] * t6 ) / det;
+        res.m[10] = ( m[12] * t4 - m[13] * t2 + m[15] * t0 ) / det;
+        res.m[11] = ( -m[8] * t4 + m[9] * t2 - m[11] * t0 ) / det;
+        res.m[12] = ( -m[4] * t9 + m[5] * t7 - m[6] * t6 ) / det;
+        res.m[13] = ( m[0] * t9 - m[1] * t7 + m[2] * t6 ) / det;
+        res.m[14] = ( -m[12] * t3 + m[13] * t1 - m[14] * t0 ) / det;
+        res.m[15] = ( m[8] * t3 - m[9] * t1 + m[10] * t0 ) / det;
+
+		return res;
+	}
+
+	inline Mat4 Mat4::Frustum( float left, float right, float bottom, float top, float zNear, float zFar )
+	{
+		Mat4 res;
+
+		res.m[0] = zNear * 2.0f / ( right - left );
+		res.m[5] = zNear * 2.0f / ( top - bottom );
+		res.m[8] = ( right + left ) / ( right - left );
+		res.m[9] = ( top + bottom ) / ( top - bottom );
+		res.m[10] = ( -zFar - zNear ) / ( zFar - zNear );
+		res.m[11] = -1;
+		res.m[14] = -2.0f * zFar * zNear / ( zFar - zNear );
+		res.m[15] = 0;
+
+		return res;
+	}
+
+	inline Mat4 Mat4::Perspective( float fovy, float aspect, float zNear, float zFar )
+	{
+		float top = zNear * Internal::tangent( fovy / 2.0f );
+		float right = top * aspect;
+		return Frustum( -right, right, -top, top, zNear, zFar );
+	}
+
+	inline Mat4 Mat4::Ortho( float left, float right, float bottom, float top, float zNear, float zFar )
+	{
+		Mat4 res;
+
+		res.m[0] = 2 / ( right - left );
+		res.m[5] = 2 / ( top - bottom );
+		res.m[10] = -2 / ( zFar - zNear );
+		res.m[12] = -( left + right ) / ( right - left );
+		res.m[13] = -( top + bottom ) / ( top - bottom );
+		res.m[14] = -( zFar + zNear ) / ( zFar - zNear );
+
+		return res;
+	}
+
+	inline Mat4 Mat4::LookAt( const Vec3& eye, const Vec3& center, const Vec3& up )
+	{
+		Mat4 res;
+
+		Vec3 Z = ( eye - center ).Normal();
+
+		Vec3 X = Vec3(
+			up.Y * Z.Z - up.Z * Z.Y,
+			up.Z * Z.X - up.X * Z.Z,
+			up.X * Z.Y - up.Y * Z.X
+		).Normal();
+
+		Vec3 Y = Vec3(
+			Z.Y * X.Z - Z.Z * X.Y,
+			Z.Z * X.X - Z.X * X.Z,
+			Z.X * X.Y - Z.Y * X.X
+		).Normal();
+
+		res.m[0] = X.X;
+        res.m[1] = Y.X;
+        res.m[2] = Z.X;
+        res.m[4] = X.Y;
+        res.m[5] = Y.Y;
+        res.m[6] = Z.Y;
+        res.m[8] = X.Z;
+        res.m[9] = Y.Z;
+        res.m[10] = Z.Z;
+		res.m[12] = -X.Dot( eye );
+		res.m[13] = -Y.Dot( eye );
+		res.m[14] = -Z.Dot( eye );
+
+		return res;
+	}
+
+	inline Vec3 Mat4::UnProject( const Vec3& vec, const Mat4& view, const Mat4& proj, const float viewport[] )
+	{
+		Mat4 inv = ( proj * view ).Inverse();
+		Vec3 v(
+			( vec.X - viewport[0] ) * 2.0f / viewport[2] - 1.0f,
+			( vec.Y - viewport[1] ) * 2.0f / viewport[3] - 1.0f,
+			2.0f * vec.Z - 1.0f
+		);
+
+		Vec3 res = inv * v;
+		float w = inv.m[3] * v.X + inv.m[7] * v.Y + inv.m[11] * v.Z + inv.m[15];
+
+		return res / w;
+	}
+
+	inline Vec3 Mat4::Project( const Vec3& vec, const Mat4& view, const Mat4& proj, const float viewport[] )
+	{
+		Mat4 trans = proj * view;
+		Vec3 v = trans * vec;
+
+		float w = trans.m[3] * vec.X + trans.m[7] * vec.Y + trans.m[11] * vec.Z + trans.m[15];
+		v = v / w;
+
+		return Vec3(
+			viewport[0] + viewport[2] * ( v.X + 1.0f ) / 2.0f,
+			viewport[1] + viewport[3] * ( v.Y + 1.0f ) / 2.0f,
+			( v.Z + 1.0f ) / 2.0f
+		);
+	}
 }
 
 #endif
\ No newline at end of file
@@ -19,56 +19,47 @@
 	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
 */
 
-#include <GL/Math/Vec4.hpp>
-#include <cmath>
+#pragma once
+
+#ifndef OOGL_PLANE_HPP
+#define OOGL_PLANE_HPP
+
+#include <GL/Math/Vec3.hpp>
 
 namespace GL
 {
-	Vec4& Vec4::operator+=( const Vec4& v )
+	/*
+		Plane of the points p where Normal.Dot( p ) + D = 0
+	*/
+	class Plane
 	{
-		X += v.X;
-		Y += v.Y;
-		Z += v.Z;
-		W += v.W;
-		return *this;
-	}
+	public:
+		OOGL_CONSTEXPR Plane( const Vec3& normal = Vec3( 0.0f, 1.0f, 0.0f ), float d = 0.0f ) : Normal( normal ), D( d ) {}
+		OOGL_CONSTEXPR Plane( const Vec3& normal, const Vec3& point );
 
-	Vec4& Vec4::operator-=( const Vec4& v )
-	{
-		X -= v.X;
-		Y -= v.Y;
-		Z -= v.Z;
-		W -= v.W;
-		return *this;
-	}
+		// Signed distance, positive on the side the normal points to (if the normal is unit length)
+		float Distance( const Vec3& v ) const;
 
-	const Vec4 Vec4::operator+( const Vec4& v ) const
-	{
-		return Vec4( X + v.X, Y + v.Y, Z + v.Z, W + v.W );
-	}
+		Plane Normalize() const;
 
-	const Vec4 Vec4::operator-( const Vec4& v ) const
-	{
-		return Vec4( X - v.X, Y - v.Y, Z - v.Z, W - v.W );
-	}
+		Vec3 Normal;
+		float D;
+	};
 
-	Vec4 operator*( const Vec4& v, float n )
+	inline OOGL_CONSTEXPR Plane::Plane( const Vec3& normal, const Vec3& point ) : Normal( normal ), D( -normal.Dot( point ) )
 	{
-		return Vec4( v.X * n, v.Y * n, v.Z * n, v.W * n );
 	}
 
-	Vec4 operator*( float n, const Vec4& v )
+	inline float Plane::Distance( const Vec3& v ) const
 	{
-		return Vec4( v.X * n, v.Y * n, v.Z * n, v.W * n );
+		return Normal.Dot( v ) + D;
 	}
 
-	Vec4 operator/( const Vec4& v, float n )
+	inline Plane Plane::Normalize() const
 	{
-		return Vec4( v.X / n, v.Y / n, v.Z / n, v.W / n );
+		float l = Normal.Length();
+		return Plane( Normal / l, D / l );
 	}
+}
 
-	Vec4 operator/( float n, const Vec4& v )
-	{
-		return Vec4( v.X / n, v.Y / n, v.Z / n, v.W / n );
-	}
-}
\ No newline at end of file
+#endif
\ No newline at end of file
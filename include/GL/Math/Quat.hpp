@@ -0,0 +1,311 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_QUAT_HPP
+#define OOGL_QUAT_HPP
+
+#include <GL/Math/Util.hpp>
+#include <GL/Math/Vec3.hpp>
+#include <GL/Math/Mat3.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <cstddef>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Quaternion
+
+		Unit quaternions represent rotations with the same conventions as
+		Mat4::Rotate. Products compose like matrices, ( a * b ) * v rotates v by b
+		first, at 16 multiplications and 12 additions instead of the 64 and 48
+		of a Mat4 product.
+	*/
+	class Quat
+	{
+	public:
+		OOGL_CONSTEXPR Quat( float x = 0.0f, float y = 0.0f, float z = 0.0f, float w = 1.0f ) : X( x ), Y( y ), Z( z ), W( w ) {}
+
+		// Rotation of ang radians around axis
+		Quat( const Vec3& axis, float ang );
+
+		// Rotation part of a matrix without scaling, Mat3 is used as a plain 3-by-3 matrix here
+		explicit Quat( const Mat3& mat );
+		explicit Quat( const Mat4& mat );
+
+		const Quat operator*( const Quat& q ) const;
+		Quat& operator*=( const Quat& q );
+
+		// Rotates v
+		const Vec3 operator*( const Vec3& v ) const;
+
+		OOGL_CONSTEXPR const Quat operator+( const Quat& q ) const;
+		OOGL_CONSTEXPR const Quat operator-( const Quat& q ) const;
+
+		friend OOGL_CONSTEXPR Quat operator*( const Quat& q, float n );
+		friend OOGL_CONSTEXPR Quat operator*( float n, const Quat& q );
+
+		OOGL_CONSTEXPR float Dot( const Quat& q ) const;
+		float Length() const;
+		Quat Normal() const;
+
+		// The conjugate is the inverse of a unit quaternion
+		OOGL_CONSTEXPR Quat Conjugate() const;
+		Quat Inverse() const;
+
+		Mat3 ToMat3() const;
+		Mat4 ToMat4() const;
+
+		// Interpolation along the shortest arc, Nlerp is cheaper but does not rotate at constant speed
+		static Quat Slerp( const Quat& a, const Quat& b, float t );
+		static Quat Nlerp( const Quat& a, const Quat& b, float t );
+
+		// out[i] = a[i] * b[i], out may be a or b
+		static void Multiply( const Quat* a, const Quat* b, Quat* out, size_t count );
+
+		float X, Y, Z, W;
+	};
+
+	namespace Internal
+	{
+		/*
+			Quaternion product
+
+			a * b is the sum of b scaled by a.W and three signed permutations of b
+			scaled by a.X, a.Y and a.Z. The terms are added in the same order on
+			every instruction set.
+		*/
+
+#if defined( OOGL_SIMD_SSE2 )
+		inline void quatPermutations( column b, column p[3] )
+		{
+			p[0] = _mm_xor_ps( _mm_shuffle_ps( b, b, _MM_SHUFFLE( 0, 1, 2, 3 ) ), _mm_set_ps( -0.0f, 0.0f, -0.0f, 0.0f ) );
+			p[1] = _mm_xor_ps( _mm_shuffle_ps( b, b, _MM_SHUFFLE( 1, 0, 3, 2 ) ), _mm_set_ps( -0.0f, -0.0f, 0.0f, 0.0f ) );
+			p[2] = _mm_xor_ps( _mm_shuffle_ps( b, b, _MM_SHUFFLE( 2, 3, 0, 1 ) ), _mm_set_ps( -0.0f, 0.0f, 0.0f, -0.0f ) );
+		}
+#elif defined( OOGL_SIMD_NEON )
+		inline void quatPermutations( column b, column p[3] )
+		{
+			static const float signs[3][4] = { { 1, -1, 1, -1 }, { 1, 1, -1, -1 }, { -1, 1, 1, -1 } };
+			float32x4_t swapped = vrev64q_f32( b );
+			p[0] = vmulq_f32( vextq_f32( swapped, swapped, 2 ), vld1q_f32( signs[0] ) );
+			p[1] = vmulq_f32( vextq_f32( b, b, 2 ), vld1q_f32( signs[1] ) );
+			p[2] = vmulq_f32( swapped, vld1q_f32( signs[2] ) );
+		}
+#else
+		inline void quatPermutations( column b, column p[3] )
+		{
+			const float* v = b.v;
+			column p0 = { { v[3], -v[2], v[1], -v[0] } };
+			column p1 = { { v[2], v[3], -v[0], -v[1] } };
+			column p2 = { { -v[1], v[0], v[3], -v[2] } };
+			p[0] = p0;
+			p[1] = p1;
+			p[2] = p2;
+		}
+#endif
+
+		inline column quatProduct( const float* a, const float* b )
+		{
+			column q = load( b ), p[3];
+			quatPermutations( q, p );
+			return madd( madd( madd( mul( q, a[3] ), p[0], a[0] ), p[1], a[1] ), p[2], a[2] );
+		}
+
+		// acc + a * b
+		inline column quatProductAdd( column acc, const float* a, const float* b )
+		{
+			column q = load( b ), p[3];
+			quatPermutations( q, p );
+			return madd( madd( madd( madd( acc, q, a[3] ), p[0], a[0] ), p[1], a[1] ), p[2], a[2] );
+		}
+
+		// The rotation in the 3-by-3 part of a column major matrix with the given column stride
+		inline Quat quatFromRotation( const float* m, int stride )
+		{
+			float m00 = m[0], m01 = m[stride], m02 = m[stride * 2];
+			float m10 = m[1], m11 = m[stride + 1], m12 = m[stride * 2 + 1];
+			float m20 = m[2], m21 = m[stride + 2], m22 = m[stride * 2 + 2];
+			float trace = m00 + m11 + m22;
+
+			// Divide by the largest component to stay accurate
+			if ( trace > 0.0f ) {
+				float s = sqrt( trace + 1.0f ) * 2.0f;
+				return Quat( ( m21 - m12 ) / s, ( m02 - m20 ) / s, ( m10 - m01 ) / s, 0.25f * s );
+			} else if ( m00 > m11 && m00 > m22 ) {
+				float s = sqrt( 1.0f + m00 - m11 - m22 ) * 2.0f;
+				return Quat( 0.25f * s, ( m01 + m10 ) / s, ( m02 + m20 ) / s, ( m21 - m12 ) / s );
+			} else if ( m11 > m22 ) {
+				float s = sqrt( 1.0f + m11 - m00 - m22 ) * 2.0f;
+				return Quat( ( m01 + m10 ) / s, 0.25f * s, ( m12 + m21 ) / s, ( m02 - m20 ) / s );
+			} else {
+				float s = sqrt( 1.0f + m22 - m00 - m11 ) * 2.0f;
+				return Quat( ( m02 + m20 ) / s, ( m12 + m21 ) / s, 0.25f * s, ( m10 - m01 ) / s );
+			}
+		}
+	}
+
+	inline Quat::Quat( const Vec3& axis, float ang )
+	{
+		float s;
+		Internal::sinCos( ang * 0.5f, s, W );
+		Vec3 a = axis.Normal() * s;
+		X = a.X;
+		Y = a.Y;
+		Z = a.Z;
+	}
+
+	inline Quat::Quat( const Mat3& mat )
+	{
+		*this = Internal::quatFromRotation( mat.m, 3 );
+	}
+
+	inline Quat::Quat( const Mat4& mat )
+	{
+		*this = Internal::quatFromRotation( mat.m, 4 );
+	}
+
+	inline const Quat Quat::operator*( const Quat& q ) const
+	{
+		Quat res;
+		Internal::store( &res.X, Internal::quatProduct( &X, &q.X ) );
+		return res;
+	}
+
+	inline Quat& Quat::operator*=( const Quat& q )
+	{
+		return *this = *this * q;
+	}
+
+	inline const Vec3 Quat::operator*( const Vec3& v ) const
+	{
+		// v + 2w( q x v ) + 2q x ( q x v ) without building the matrix
+		Vec3 q( X, Y, Z );
+		Vec3 t = q.Cross( v ) * 2.0f;
+		return v + t * W + q.Cross( t );
+	}
+
+	inline OOGL_CONSTEXPR const Quat Quat::operator+( const Quat& q ) const
+	{
+		return Quat( X + q.X, Y + q.Y, Z + q.Z, W + q.W );
+	}
+
+	inline OOGL_CONSTEXPR const Quat Quat::operator-( const Quat& q ) const
+	{
+		return Quat( X - q.X, Y - q.Y, Z - q.Z, W - q.W );
+	}
+
+	inline OOGL_CONSTEXPR Quat operator*( const Quat& q, float n )
+	{
+		return Quat( q.X * n, q.Y * n, q.Z * n, q.W * n );
+	}
+
+	inline OOGL_CONSTEXPR Quat operator*( float n, const Quat& q )
+	{
+		return Quat( q.X * n, q.Y * n, q.Z * n, q.W * n );
+	}
+
+	inline OOGL_CONSTEXPR float Quat::Dot( const Quat& q ) const
+	{
+		return X * q.X + Y * q.Y + Z * q.Z + W * q.W;
+	}
+
+	inline float Quat::Length() const
+	{
+		return sqrt( X*X + Y*Y + Z*Z + W*W );
+	}
+
+	inline Quat Quat::Normal() const
+	{
+#if defined( OOGL_FAST_MATH )
+		return *this * Fast::RSqrt( Dot( *this ) );
+#else
+		return *this * ( 1.0f / Length() );
+#endif
+	}
+
+	inline OOGL_CONSTEXPR Quat Quat::Conjugate() const
+	{
+		return Quat( -X, -Y, -Z, W );
+	}
+
+	inline Quat Quat::Inverse() const
+	{
+		return Conjugate() * ( 1.0f / Dot( *this ) );
+	}
+
+	inline Mat3 Quat::ToMat3() const
+	{
+		float xx = X * X, yy = Y * Y, zz = Z * Z;
+		float xy = X * Y, xz = X * Z, yz = Y * Z;
+		float wx = W * X, wy = W * Y, wz = W * Z;
+
+		return Mat3(
+			1.0f - 2.0f * ( yy + zz ), 2.0f * ( xy - wz ), 2.0f * ( xz + wy ),
+			2.0f * ( xy + wz ), 1.0f - 2.0f * ( xx + zz ), 2.0f * ( yz - wx ),
+			2.0f * ( xz - wy ), 2.0f * ( yz + wx ), 1.0f - 2.0f * ( xx + yy )
+		);
+	}
+
+	inline Mat4 Quat::ToMat4() const
+	{
+		Mat3 r = ToMat3();
+		const float* m = r.m;
+
+		return Mat4(
+			m[0], m[3], m[6], 0.0f,
+			m[1], m[4], m[7], 0.0f,
+			m[2], m[5], m[8], 0.0f,
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+	}
+
+	inline Quat Quat::Slerp( const Quat& a, const Quat& b, float t )
+	{
+		// q and -q are the same rotation, take the one closest to a
+		float d = a.Dot( b );
+		Quat c = d < 0.0f ? b * -1.0f : b;
+		d = fabsf( d );
+
+		// Nearly parallel quaternions make sin( theta ) too small to divide by
+		if ( d > 0.9995f ) return ( a + ( c - a ) * t ).Normal();
+
+		float theta = acos( d );
+		float s = 1.0f / sin( theta );
+		return a * ( sin( ( 1.0f - t ) * theta ) * s ) + c * ( sin( t * theta ) * s );
+	}
+
+	inline Quat Quat::Nlerp( const Quat& a, const Quat& b, float t )
+	{
+		Quat c = a.Dot( b ) < 0.0f ? b * -1.0f : b;
+		return ( a + ( c - a ) * t ).Normal();
+	}
+
+	inline void Quat::Multiply( const Quat* a, const Quat* b, Quat* out, size_t count )
+	{
+		for ( size_t i = 0; i < count; i++ )
+			Internal::store( &out[i].X, Internal::quatProduct( &a[i].X, &b[i].X ) );
+	}
+}
+
+#endif
\ No newline at end of file
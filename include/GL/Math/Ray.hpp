@@ -0,0 +1,118 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_RAY_HPP
+#define OOGL_RAY_HPP
+
+#include <GL/Math/Vec3.hpp>
+#include <GL/Math/AABB.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace GL
+{
+	/*
+		Ray, distances along it are in multiples of the direction vector
+	*/
+	class Ray
+	{
+	public:
+		OOGL_CONSTEXPR Ray( const Vec3& origin = Vec3(), const Vec3& direction = Vec3( 0.0f, 0.0f, -1.0f ) ) : Origin( origin ), Direction( direction ) {}
+
+		// Ray from the near to the far plane through a window position, see Mat4::UnProject
+		static Ray FromScreen( float x, float y, const Mat4& view, const Mat4& proj, const float viewport[] );
+
+		const Vec3 At( float t ) const;
+
+		// Distances at which the ray enters and leaves the box
+		bool Intersects( const AABB& box, float& tmin, float& tmax ) const;
+
+		// Distance and barycentric coordinates of v1 and v2 where the ray hits the triangle
+		bool Intersects( const Vec3& v0, const Vec3& v1, const Vec3& v2, float& t, float& u, float& v ) const;
+
+		Vec3 Origin, Direction;
+	};
+
+	inline Ray Ray::FromScreen( float x, float y, const Mat4& view, const Mat4& proj, const float viewport[] )
+	{
+		Vec3 nearPoint = Mat4::UnProject( Vec3( x, y, 0.0f ), view, proj, viewport );
+		Vec3 farPoint = Mat4::UnProject( Vec3( x, y, 1.0f ), view, proj, viewport );
+		return Ray( nearPoint, farPoint - nearPoint );
+	}
+
+	inline const Vec3 Ray::At( float t ) const
+	{
+		return Origin + Direction * t;
+	}
+
+	inline bool Ray::Intersects( const AABB& box, float& tmin, float& tmax ) const
+	{
+		// Slab test, divisions by zero give infinities that compare correctly
+		const float* o = &Origin.X;
+		const float* d = &Direction.X;
+		const float* lo = &box.Min.X;
+		const float* hi = &box.Max.X;
+
+		tmin = -std::numeric_limits<float>::infinity();
+		tmax = std::numeric_limits<float>::infinity();
+
+		for ( int i = 0; i < 3; i++ )
+		{
+			float inv = 1.0f / d[i];
+			float t0 = ( lo[i] - o[i] ) * inv;
+			float t1 = ( hi[i] - o[i] ) * inv;
+			if ( inv < 0.0f ) std::swap( t0, t1 );
+
+			tmin = t0 > tmin ? t0 : tmin;
+			tmax = t1 < tmax ? t1 : tmax;
+		}
+
+		return tmin <= tmax;
+	}
+
+	inline bool Ray::Intersects( const Vec3& v0, const Vec3& v1, const Vec3& v2, float& t, float& u, float& v ) const
+	{
+		// Möller-Trumbore
+		Vec3 e1 = v1 - v0;
+		Vec3 e2 = v2 - v0;
+		Vec3 p = Direction.Cross( e2 );
+		float det = e1.Dot( p );
+		if ( fabsf( det ) < 1e-12f ) return false;
+
+		float invDet = 1.0f / det;
+		Vec3 s = Origin - v0;
+		u = s.Dot( p ) * invDet;
+		if ( u < 0.0f || u > 1.0f ) return false;
+
+		Vec3 q = s.Cross( e1 );
+		v = Direction.Dot( q ) * invDet;
+		if ( v < 0.0f || u + v > 1.0f ) return false;
+
+		t = e2.Dot( q ) * invDet;
+		return true;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_SPHERE_HPP
+#define OOGL_SPHERE_HPP
+
+#include <GL/Math/Vec3.hpp>
+#include <cstddef>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Bounding sphere
+	*/
+	class Sphere
+	{
+	public:
+		OOGL_CONSTEXPR Sphere( const Vec3& center = Vec3(), float radius = 0.0f ) : Center( center ), Radius( radius ) {}
+
+		// Approximate smallest sphere around the points, at most a few percent
+		// larger than optimal (Ritter's algorithm)
+		static Sphere FromPoints( const Vec3* points, size_t count, size_t stride = sizeof( Vec3 ) );
+
+		bool Contains( const Vec3& v ) const;
+		bool Intersects( const Sphere& sphere ) const;
+
+		Vec3 Center;
+		float Radius;
+	};
+
+	namespace Internal
+	{
+		inline const Vec3& pointAt( const Vec3* points, size_t i, size_t stride )
+		{
+			return *(const Vec3*)( (const char*)points + i * stride );
+		}
+	}
+
+	inline Sphere Sphere::FromPoints( const Vec3* points, size_t count, size_t stride )
+	{
+		if ( count == 0 ) return Sphere();
+
+		// Start with the sphere between two points that are far apart
+		const Vec3& first = Internal::pointAt( points, 0, stride );
+		Vec3 a = first, b = first;
+		float maxDist = 0.0f;
+
+		for ( size_t i = 0; i < count; i++ )
+		{
+			float d = ( Internal::pointAt( points, i, stride ) - first ).LengthSqr();
+			if ( d > maxDist ) { maxDist = d; a = Internal::pointAt( points, i, stride ); }
+		}
+
+		maxDist = 0.0f;
+		for ( size_t i = 0; i < count; i++ )
+		{
+			float d = ( Internal::pointAt( points, i, stride ) - a ).LengthSqr();
+			if ( d > maxDist ) { maxDist = d; b = Internal::pointAt( points, i, stride ); }
+		}
+
+		Sphere sphere( ( a + b ) * 0.5f, sqrt( maxDist ) * 0.5f );
+
+		// Grow it to include the points outside of it
+		for ( size_t i = 0; i < count; i++ )
+		{
+			const Vec3& p = Internal::pointAt( points, i, stride );
+			float d = ( p - sphere.Center ).Length();
+
+			if ( d > sphere.Radius ) {
+				float radius = ( sphere.Radius + d ) * 0.5f;
+				sphere.Center += ( p - sphere.Center ) * ( ( radius - sphere.Radius ) / d );
+				sphere.Radius = radius;
+			}
+		}
+
+		return sphere;
+	}
+
+	inline bool Sphere::Contains( const Vec3& v ) const
+	{
+		return ( v - Center ).LengthSqr() <= Radius * Radius;
+	}
+
+	inline bool Sphere::Intersects( const Sphere& sphere ) const
+	{
+		float r = Radius + sphere.Radius;
+		return ( sphere.Center - Center ).LengthSqr() <= r * r;
+	}
+}
+
+#endif
\ No newline at end of file
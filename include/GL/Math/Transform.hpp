@@ -0,0 +1,93 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_TRANSFORM_HPP
+#define OOGL_TRANSFORM_HPP
+
+#include <GL/Math/Util.hpp>
+#include <GL/Math/Vec3.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <GL/Math/Quat.hpp>
+
+namespace GL
+{
+	/*
+		Translation, rotation and scale
+
+		The matrix applies the scale first, then the rotation and finally the
+		translation. Decomposing a matrix assumes that it is affine, shearing
+		is lost and a mirroring ends up as a negative X scale.
+	*/
+	class Transform
+	{
+	public:
+		OOGL_CONSTEXPR Transform( const Vec3& translation = Vec3(), const Quat& rotation = Quat(), const Vec3& scale = Vec3( 1.0f, 1.0f, 1.0f ) ) : Translation( translation ), Rotation( rotation ), Scale( scale ) {}
+		explicit Transform( const Mat4& mat );
+
+		Mat4 ToMat4() const;
+
+		Vec3 Translation;
+		Quat Rotation;
+		Vec3 Scale;
+	};
+
+	inline Transform::Transform( const Mat4& mat )
+	{
+		const float* m = mat.m;
+		Vec3 c0( m[0], m[1], m[2] ), c1( m[4], m[5], m[6] ), c2( m[8], m[9], m[10] );
+
+		Translation = Vec3( m[12], m[13], m[14] );
+		Scale = Vec3( c0.Length(), c1.Length(), c2.Length() );
+		if ( c0.Dot( c1.Cross( c2 ) ) < 0.0f ) Scale.X = -Scale.X;
+
+		// Columns without length get no rotation from them
+		if ( Scale.X != 0.0f && Scale.Y != 0.0f && Scale.Z != 0.0f ) {
+			c0 = c0 / Scale.X;
+			c1 = c1 / Scale.Y;
+			c2 = c2 / Scale.Z;
+
+			Rotation = Quat( Mat3(
+				c0.X, c1.X, c2.X,
+				c0.Y, c1.Y, c2.Y,
+				c0.Z, c1.Z, c2.Z
+			) ).Normal();
+		}
+	}
+
+	inline Mat4 Transform::ToMat4() const
+	{
+		Mat3 rotation = Rotation.ToMat3();
+		const float* r = rotation.m;
+		const Vec3& s = Scale;
+		const Vec3& t = Translation;
+
+		return Mat4(
+			r[0] * s.X, r[3] * s.Y, r[6] * s.Z, t.X,
+			r[1] * s.X, r[4] * s.Y, r[7] * s.Z, t.Y,
+			r[2] * s.X, r[5] * s.Y, r[8] * s.Z, t.Z,
+			0.0f, 0.0f, 0.0f, 1.0f
+		);
+	}
+}
+
+#endif
\ No newline at end of file
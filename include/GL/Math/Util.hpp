@@ -24,19 +24,154 @@
 #ifndef OOGL_UTIL_HPP
 #define OOGL_UTIL_HPP
 
+#include <GL/SIMD.hpp>
+#include <cmath>
+
+#if defined( OOGL_SIMD_SSE2 )
+	#include <emmintrin.h>
+#elif defined( OOGL_SIMD_NEON )
+	#include <arm_neon.h>
+#endif
+
+/*
+	Compile-time evaluation of the math classes
+
+	The math classes rely on constexpr and brace initialized array members,
+	which Visual Studio only supports from 2015 on, so older versions are
+	stopped here instead of failing somewhere in the templates.
+*/
+
+#if defined( _MSC_VER ) && _MSC_VER < 1900
+	#error OOGL requires Visual Studio 2015 or newer
+#endif
+
+#define OOGL_CONSTEXPR constexpr
+
+/*
+	Keeps rarely taken slow paths out of the inlined fast paths
+*/
+
+#if defined( _MSC_VER )
+	#define OOGL_NOINLINE __declspec( noinline )
+#elif defined( __GNUC__ )
+	#define OOGL_NOINLINE __attribute__(( noinline ))
+#else
+	#define OOGL_NOINLINE
+#endif
+
 namespace GL
 {
-	const float PI = 3.14159265358979323846f;
+	OOGL_CONSTEXPR const float PI = 3.14159265358979323846f;
 
-	inline float Rad( float degrees )
+	inline OOGL_CONSTEXPR float Rad( float degrees )
 	{
 		return degrees / 180.0f * PI;
 	}
 
-	inline float Deg( float radians )
+	inline OOGL_CONSTEXPR float Deg( float radians )
 	{
 		return radians / PI * 180.0f;
 	}
+
+	/*
+		Fast approximations of the standard functions
+
+		SinCos and Tan reduce the angle to [-PI/4, PI/4] and evaluate minimax
+		polynomials. The sine and cosine are within 8e-8 of the exact values for
+		|ang| <= 8192, which is 1.5 ulp for |ang| <= PI. The tangent is within
+		4 ulp for |ang| <= PI. Angles outside [-8192, 8192], infinities and NaN
+		are passed to the standard functions instead, since the reduction would
+		lose precision and the quadrant would not fit in an int.
+
+		RSqrt is the hardware estimate of 1 / sqrt( x ) refined with Newton's
+		method, within 3e-7 relative error for positive normal floats. It falls
+		back to 1 / sqrt( x ) without SIMD.
+
+		Defining OOGL_FAST_MATH makes the math classes use these for rotations,
+		projections and normalization.
+	*/
+	namespace Fast
+	{
+		void SinCos( float ang, float& s, float& c );
+		float Tan( float ang );
+		float RSqrt( float x );
+
+		// Largest angle SinCos reduces itself
+		const float SIN_COS_RANGE = 8192.0f;
+	}
+
+	namespace Internal
+	{
+		OOGL_NOINLINE inline void sinCosOutOfRange( float ang, float& s, float& c )
+		{
+			s = sin( ang );
+			c = cos( ang );
+		}
+	}
+
+	inline void Fast::SinCos( float ang, float& s, float& c )
+	{
+		// Written so NaN fails the test as well
+		if ( !( fabsf( ang ) <= SIN_COS_RANGE ) ) {
+			Internal::sinCosOutOfRange( ang, s, c );
+			return;
+		}
+
+		// Nearest multiple of PI/2, subtracted in three parts that are exact for
+		// small multiples
+		float k = ang * 0.636619772f;
+		int quadrant = (int)( k >= 0.0f ? k + 0.5f : k - 0.5f );
+		k = (float)quadrant;
+		float r = ( ( ang - k * 1.5703125f ) - k * 4.837512969970703125e-4f ) - k * 7.54978995489188216e-8f;
+
+		float z = r * r;
+		float sr = ( ( -1.9515295891e-4f * z + 8.3321608736e-3f ) * z - 1.6666654611e-1f ) * z * r + r;
+		float cr = ( ( 2.443315711809948e-5f * z - 1.388731625493765e-3f ) * z + 4.166664568298827e-2f ) * z * z - 0.5f * z + 1.0f;
+
+		// Rotate the results by the quadrant, with lookups since branches on
+		// the quadrant are hard to predict
+		const float values[2] = { sr, cr };
+		const float signs[2] = { 1.0f, -1.0f };
+		s = values[quadrant & 1] * signs[( quadrant >> 1 ) & 1];
+		c = values[~quadrant & 1] * signs[( ( quadrant + 1 ) >> 1 ) & 1];
+	}
+
+	inline float Fast::Tan( float ang )
+	{
+		float s, c;
+		SinCos( ang, s, c );
+		return s / c;
+	}
+
+	inline float Fast::RSqrt( float x )
+	{
+#if defined( OOGL_SIMD_SSE2 )
+		// The estimate has 12 correct bits, one step gives about 22
+		float y = _mm_cvtss_f32( _mm_rsqrt_ss( _mm_set_ss( x ) ) );
+		return y * ( 1.5f - 0.5f * x * y * y );
+#elif defined( OOGL_SIMD_NEON )
+		// The estimate has 8 correct bits, which needs two steps
+		float32x2_t v = vdup_n_f32( x );
+		float32x2_t y = vrsqrte_f32( v );
+		y = vmul_f32( y, vrsqrts_f32( vmul_f32( v, y ), y ) );
+		y = vmul_f32( y, vrsqrts_f32( vmul_f32( v, y ), y ) );
+		return vget_lane_f32( y, 0 );
+#else
+		return 1.0f / sqrt( x );
+#endif
+	}
+
+	namespace Internal
+	{
+		// The versions the math classes use
+#if defined( OOGL_FAST_MATH )
+		inline void sinCos( float ang, float& s, float& c ) { Fast::SinCos( ang, s, c ); }
+		inline float tangent( float ang ) { return Fast::Tan( ang ); }
+#else
+		inline void sinCos( float ang, float& s, float& c ) { s = sin( ang ); c = cos( ang ); }
+		inline float tangent( float ang ) { return tan( ang ); }
+#endif
+	}
 }
 
 #endif
\ No newline at end of file
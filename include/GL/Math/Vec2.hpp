@@ -24,6 +24,9 @@
 #ifndef OOGL_VEC2_HPP
 #define OOGL_VEC2_HPP
 
+#include <GL/Math/Util.hpp>
+#include <cmath>
+
 namespace GL
 {
 	/*
@@ -32,24 +35,24 @@ namespace GL
 	class Vec2
 	{
 	public:
-		Vec2( float x = 0.0f, float y = 0.0f ) : X( x ), Y( y ) {}
+		OOGL_CONSTEXPR Vec2( float x = 0.0f, float y = 0.0f ) : X( x ), Y( y ) {}
 
 		Vec2& operator+=( const Vec2& v );
 		Vec2& operator-=( const Vec2& v );
 
-		const Vec2 operator+( const Vec2& v ) const;
-		const Vec2 operator-( const Vec2& v ) const;
+		OOGL_CONSTEXPR const Vec2 operator+( const Vec2& v ) const;
+		OOGL_CONSTEXPR const Vec2 operator-( const Vec2& v ) const;
 
-		friend Vec2 operator*( const Vec2& v, float n );
-		friend Vec2 operator*( float n, const Vec2& v );
+		friend OOGL_CONSTEXPR Vec2 operator*( const Vec2& v, float n );
+		friend OOGL_CONSTEXPR Vec2 operator*( float n, const Vec2& v );
 
-		friend Vec2 operator/( const Vec2& v, float n );
-		friend Vec2 operator/( float n, const Vec2& v );
+		friend OOGL_CONSTEXPR Vec2 operator/( const Vec2& v, float n );
+		friend OOGL_CONSTEXPR Vec2 operator/( float n, const Vec2& v );
 
-		float Dot( const Vec2& v ) const;
+		OOGL_CONSTEXPR float Dot( const Vec2& v ) const;
 		float Angle( const Vec2& v ) const;
 
-		float LengthSqr() const;
+		OOGL_CONSTEXPR float LengthSqr() const;
 		float Length() const;
 		float Distance( const Vec2& v ) const;
 
@@ -57,6 +60,84 @@ namespace GL
 
 		float X, Y;
 	};
+
+	inline Vec2& Vec2::operator+=( const Vec2& v )
+	{
+		X += v.X;
+		Y += v.Y;
+		return *this;
+	}
+
+	inline Vec2& Vec2::operator-=( const Vec2& v )
+	{
+		X -= v.X;
+		Y -= v.Y;
+		return *this;
+	}
+
+	inline OOGL_CONSTEXPR const Vec2 Vec2::operator+( const Vec2& v ) const
+	{
+		return Vec2( X + v.X, Y + v.Y );
+	}
+
+	inline OOGL_CONSTEXPR const Vec2 Vec2::operator-( const Vec2& v ) const
+	{
+		return Vec2( X - v.X, Y - v.Y );
+	}
+
+	inline OOGL_CONSTEXPR Vec2 operator*( const Vec2& v, float n )
+	{
+		return Vec2( v.X * n, v.Y * n );
+	}
+
+	inline OOGL_CONSTEXPR Vec2 operator*( float n, const Vec2& v )
+	{
+		return Vec2( v.X * n, v.Y * n );
+	}
+
+	inline OOGL_CONSTEXPR Vec2 operator/( const Vec2& v, float n )
+	{
+		return Vec2( v.X / n, v.Y / n );
+	}
+
+	inline OOGL_CONSTEXPR Vec2 operator/( float n, const Vec2& v )
+	{
+		return Vec2( v.X / n, v.Y / n );
+	}
+
+	inline OOGL_CONSTEXPR float Vec2::Dot( const Vec2& v ) const
+	{
+		return X * v.X + Y * v.Y;
+	}
+
+	inline float Vec2::Angle( const Vec2& v ) const
+	{
+		return acos( Dot( v ) / Length() / v.Length() );
+	}
+
+	inline OOGL_CONSTEXPR float Vec2::LengthSqr() const
+	{
+		return X*X + Y*Y;
+	}
+
+	inline float Vec2::Length() const
+	{
+		return sqrt( X*X + Y*Y );
+	}
+
+	inline float Vec2::Distance( const Vec2& v ) const
+	{
+		return ( *this - v ).Length();
+	}
+
+	inline const Vec2 Vec2::Normal() const
+	{
+#if defined( OOGL_FAST_MATH )
+		return Fast::RSqrt( LengthSqr() ) * *this;
+#else
+		return *this / Length();
+#endif
+	}
 }
 
 #endif
\ No newline at end of file
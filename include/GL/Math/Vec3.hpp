@@ -24,6 +24,9 @@
 #ifndef OOGL_VEC3_HPP
 #define OOGL_VEC3_HPP
 
+#include <GL/Math/Util.hpp>
+#include <cmath>
+
 namespace GL
 {
 	/*
@@ -32,26 +35,26 @@ namespace GL
 	class Vec3
 	{
 	public:
-		Vec3( float x = 0.0f, float y = 0.0f, float z = 0.0f ) : X( x ), Y( y ), Z( z ) {}
+		OOGL_CONSTEXPR Vec3( float x = 0.0f, float y = 0.0f, float z = 0.0f ) : X( x ), Y( y ), Z( z ) {}
 
 		Vec3& operator+=( const Vec3& v );
 		Vec3& operator-=( const Vec3& v );
 
-		const Vec3 operator+( const Vec3& v ) const;
-		const Vec3 operator-( const Vec3& v ) const;
+		OOGL_CONSTEXPR const Vec3 operator+( const Vec3& v ) const;
+		OOGL_CONSTEXPR const Vec3 operator-( const Vec3& v ) const;
 
-		friend Vec3 operator*( const Vec3& v, float n );
-		friend Vec3 operator*( float n, const Vec3& v );
+		friend OOGL_CONSTEXPR Vec3 operator*( const Vec3& v, float n );
+		friend OOGL_CONSTEXPR Vec3 operator*( float n, const Vec3& v );
 
-		friend Vec3 operator/( const Vec3& v, float n );
-		friend Vec3 operator/( float n, const Vec3& v );
+		friend OOGL_CONSTEXPR Vec3 operator/( const Vec3& v, float n );
+		friend OOGL_CONSTEXPR Vec3 operator/( float n, const Vec3& v );
 
-		const Vec3 Cross( const Vec3& v ) const;
+		OOGL_CONSTEXPR const Vec3 Cross( const Vec3& v ) const;
 
-		float Dot( const Vec3& v ) const;
+		OOGL_CONSTEXPR float Dot( const Vec3& v ) const;
 		float Angle( const Vec3& v ) const;
 
-		float LengthSqr() const;
+		OOGL_CONSTEXPR float LengthSqr() const;
 		float Length() const;
 		float Distance( const Vec3& v ) const;
 
@@ -59,6 +62,91 @@ namespace GL
 
 		float X, Y, Z;
 	};
+
+	inline Vec3& Vec3::operator+=( const Vec3& v )
+	{
+		X += v.X;
+		Y += v.Y;
+		Z += v.Z;
+		return *this;
+	}
+
+	inline Vec3& Vec3::operator-=( const Vec3& v )
+	{
+		X -= v.X;
+		Y -= v.Y;
+		Z -= v.Z;
+		return *this;
+	}
+
+	inline OOGL_CONSTEXPR const Vec3 Vec3::operator+( const Vec3& v ) const
+	{
+		return Vec3( X + v.X, Y + v.Y, Z + v.Z );
+	}
+
+	inline OOGL_CONSTEXPR const Vec3 Vec3::operator-( const Vec3& v ) const
+	{
+		return Vec3( X - v.X, Y - v.Y, Z - v.Z );
+	}
+
+	inline OOGL_CONSTEXPR Vec3 operator*( const Vec3& v, float n )
+	{
+		return Vec3( v.X * n, v.Y * n, v.Z * n );
+	}
+
+	inline OOGL_CONSTEXPR Vec3 operator*( float n, const Vec3& v )
+	{
+		return Vec3( v.X * n, v.Y * n, v.Z * n );
+	}
+
+	inline OOGL_CONSTEXPR Vec3 operator/( const Vec3& v, float n )
+	{
+		return Vec3( v.X / n, v.Y / n, v.Z / n );
+	}
+
+	inline OOGL_CONSTEXPR Vec3 operator/( float n, const Vec3& v )
+	{
+		return Vec3( v.X / n, v.Y / n, v.Z / n );
+	}
+
+	inline OOGL_CONSTEXPR const Vec3 Vec3::Cross( const Vec3& v ) const
+	{
+		return Vec3( Y*v.Z - Z*v.Y, Z*v.X - X*v.Z, X*v.Y - Y*v.X );
+	}
+
+	inline OOGL_CONSTEXPR float Vec3::Dot( const Vec3& v ) const
+	{
+		return X * v.X + Y * v.Y + Z * v.Z;
+	}
+
+	inline float Vec3::Angle( const Vec3& v ) const
+	{
+		return acos( Dot( v ) / Length() / v.Length() );
+	}
+
+	inline OOGL_CONSTEXPR float Vec3::LengthSqr() const
+	{
+		return X*X + Y*Y + Z*Z;
+	}
+
+	inline float Vec3::Length() const
+	{
+		return sqrt( X*X + Y*Y + Z*Z );
+	}
+
+	inline float Vec3::Distance( const Vec3& v ) const
+	{
+		return ( *this - v ).Length();
+	}
+
+	inline const Vec3 Vec3::Normal() const
+	{
+#if defined( OOGL_FAST_MATH )
+		return *this * Fast::RSqrt( LengthSqr() );
+#else
+		return *this / Length();
+#endif
+	}
 }
 
 #endif
\ No newline at end of file
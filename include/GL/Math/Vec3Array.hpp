@@ -0,0 +1,514 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_VEC3ARRAY_HPP
+#define OOGL_VEC3ARRAY_HPP
+
+#include <GL/SIMD.hpp>
+#include <GL/Math/Vec3.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <new>
+
+#if defined( OOGL_SIMD_AVX2 )
+	#include <immintrin.h>
+#elif defined( OOGL_SIMD_SSE2 )
+	#include <emmintrin.h>
+#elif defined( OOGL_SIMD_NEON )
+	#include <arm_neon.h>
+#endif
+
+namespace GL
+{
+	namespace Internal
+	{
+		/*
+			Allocator for streams that start on a 32 byte boundary
+		*/
+		template < typename T >
+		struct alignedAllocator
+		{
+			typedef T value_type;
+
+			template < typename U >
+			struct rebind
+			{
+				typedef alignedAllocator<U> other;
+			};
+
+			alignedAllocator() {}
+			template < typename U > alignedAllocator( const alignedAllocator<U>& ) {}
+
+			T* allocate( size_t n )
+			{
+				// The original pointer is kept right in front of the aligned block
+				char* raw = (char*)::operator new( n * sizeof( T ) + 32 + sizeof( void* ) );
+				char* p = raw + sizeof( void* );
+				p += ( 32 - (size_t)p % 32 ) % 32;
+				( (void**)p )[-1] = raw;
+				return (T*)p;
+			}
+
+			void deallocate( T* p, size_t )
+			{
+				::operator delete( ( (void**)p )[-1] );
+			}
+		};
+
+		template < typename T, typename U >
+		inline bool operator==( const alignedAllocator<T>&, const alignedAllocator<U>& ) { return true; }
+		template < typename T, typename U >
+		inline bool operator!=( const alignedAllocator<T>&, const alignedAllocator<U>& ) { return false; }
+
+		/*
+			Lane arithmetic
+
+			A group of floats that is processed by single instructions, 8 wide
+			with AVX2 and 4 wide with SSE2 or NEON. The operations are the same
+			IEEE operations as the scalar code, so results match Vec3 and Mat4
+			exactly.
+		*/
+
+#if defined( OOGL_SIMD_AVX2 )
+		struct lanes
+		{
+			enum { Count = 8 };
+			__m256 v;
+		};
+
+		inline lanes loadLanes( const float* p ) { lanes r = { _mm256_load_ps( p ) }; return r; }
+		inline lanes splatLanes( float s ) { lanes r = { _mm256_set1_ps( s ) }; return r; }
+		inline void storeLanes( float* p, lanes a ) { _mm256_store_ps( p, a.v ); }
+		inline void storeLanesUnaligned( float* p, lanes a ) { _mm256_storeu_ps( p, a.v ); }
+		inline lanes operator+( lanes a, lanes b ) { lanes r = { _mm256_add_ps( a.v, b.v ) }; return r; }
+		inline lanes operator-( lanes a, lanes b ) { lanes r = { _mm256_sub_ps( a.v, b.v ) }; return r; }
+		inline lanes operator*( lanes a, lanes b ) { lanes r = { _mm256_mul_ps( a.v, b.v ) }; return r; }
+		inline lanes operator/( lanes a, lanes b ) { lanes r = { _mm256_div_ps( a.v, b.v ) }; return r; }
+		inline lanes sqrtLanes( lanes a ) { lanes r = { _mm256_sqrt_ps( a.v ) }; return r; }
+		inline lanes rsqrtLanes( lanes a )
+		{
+			lanes y = { _mm256_rsqrt_ps( a.v ) };
+			return y * ( splatLanes( 1.5f ) - splatLanes( 0.5f ) * a * y * y );
+		}
+#elif defined( OOGL_SIMD_SSE2 )
+		struct lanes
+		{
+			enum { Count = 4 };
+			__m128 v;
+		};
+
+		inline lanes loadLanes( const float* p ) { lanes r = { _mm_load_ps( p ) }; return r; }
+		inline lanes splatLanes( float s ) { lanes r = { _mm_set1_ps( s ) }; return r; }
+		inline void storeLanes( float* p, lanes a ) { _mm_store_ps( p, a.v ); }
+		inline void storeLanesUnaligned( float* p, lanes a ) { _mm_storeu_ps( p, a.v ); }
+		inline lanes operator+( lanes a, lanes b ) { lanes r = { _mm_add_ps( a.v, b.v ) }; return r; }
+		inline lanes operator-( lanes a, lanes b ) { lanes r = { _mm_sub_ps( a.v, b.v ) }; return r; }
+		inline lanes operator*( lanes a, lanes b ) { lanes r = { _mm_mul_ps( a.v, b.v ) }; return r; }
+		inline lanes operator/( lanes a, lanes b ) { lanes r = { _mm_div_ps( a.v, b.v ) }; return r; }
+		inline lanes sqrtLanes( lanes a ) { lanes r = { _mm_sqrt_ps( a.v ) }; return r; }
+		inline lanes rsqrtLanes( lanes a )
+		{
+			lanes y = { _mm_rsqrt_ps( a.v ) };
+			return y * ( splatLanes( 1.5f ) - splatLanes( 0.5f ) * a * y * y );
+		}
+#elif defined( OOGL_SIMD_NEON ) && ( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+		// 32-bit NEON has no exact division or square root and uses the scalar path
+		struct lanes
+		{
+			enum { Count = 4 };
+			float32x4_t v;
+		};
+
+		inline lanes loadLanes( const float* p ) { lanes r = { vld1q_f32( p ) }; return r; }
+		inline lanes splatLanes( float s ) { lanes r = { vdupq_n_f32( s ) }; return r; }
+		inline void storeLanes( float* p, lanes a ) { vst1q_f32( p, a.v ); }
+		inline void storeLanesUnaligned( float* p, lanes a ) { vst1q_f32( p, a.v ); }
+		inline lanes operator+( lanes a, lanes b ) { lanes r = { vaddq_f32( a.v, b.v ) }; return r; }
+		inline lanes operator-( lanes a, lanes b ) { lanes r = { vsubq_f32( a.v, b.v ) }; return r; }
+		inline lanes operator*( lanes a, lanes b ) { lanes r = { vmulq_f32( a.v, b.v ) }; return r; }
+		inline lanes operator/( lanes a, lanes b ) { lanes r = { vdivq_f32( a.v, b.v ) }; return r; }
+		inline lanes sqrtLanes( lanes a ) { lanes r = { vsqrtq_f32( a.v ) }; return r; }
+		inline lanes rsqrtLanes( lanes a )
+		{
+			float32x4_t y = vrsqrteq_f32( a.v );
+			y = vmulq_f32( y, vrsqrtsq_f32( vmulq_f32( a.v, y ), y ) );
+			lanes r = { vmulq_f32( y, vrsqrtsq_f32( vmulq_f32( a.v, y ), y ) ) };
+			return r;
+		}
+#else
+		struct lanes
+		{
+			enum { Count = 1 };
+			float v;
+		};
+
+		inline lanes loadLanes( const float* p ) { lanes r = { *p }; return r; }
+		inline lanes splatLanes( float s ) { lanes r = { s }; return r; }
+		inline void storeLanes( float* p, lanes a ) { *p = a.v; }
+		inline void storeLanesUnaligned( float* p, lanes a ) { *p = a.v; }
+		inline lanes operator+( lanes a, lanes b ) { lanes r = { a.v + b.v }; return r; }
+		inline lanes operator-( lanes a, lanes b ) { lanes r = { a.v - b.v }; return r; }
+		inline lanes operator*( lanes a, lanes b ) { lanes r = { a.v * b.v }; return r; }
+		inline lanes operator/( lanes a, lanes b ) { lanes r = { a.v / b.v }; return r; }
+		inline lanes sqrtLanes( lanes a ) { lanes r = { sqrtf( a.v ) }; return r; }
+		inline lanes rsqrtLanes( lanes a ) { lanes r = { Fast::RSqrt( a.v ) }; return r; }
+#endif
+
+		// Stores the first count floats of the lanes to unaligned memory
+		inline void storeLanesPartial( float* p, lanes a, size_t count )
+		{
+			float tmp[lanes::Count];
+			storeLanesUnaligned( tmp, a );
+			memcpy( p, tmp, count * sizeof( float ) );
+		}
+	}
+
+	/*
+		Array of 3D vectors stored as separate X, Y and Z streams
+
+		Structure-of-arrays layout for processing many vectors at once. Every
+		stream is 32 byte aligned and zero padded to a multiple of 8 floats, so
+		the operations below always work on whole lanes.
+	*/
+	class Vec3Array
+	{
+	public:
+		Vec3Array( size_t count = 0 );
+		Vec3Array( const Vec3* v, size_t count );
+
+		size_t Count() const;
+
+		// New vectors are zero
+		void Resize( size_t count );
+
+		// Conversion from and to arrays of Vec3
+		void Assign( const Vec3* v, size_t count );
+		void CopyTo( Vec3* out ) const;
+
+		Vec3 Get( size_t i ) const;
+		void Set( size_t i, const Vec3& v );
+
+		float* X();
+		float* Y();
+		float* Z();
+		const float* X() const;
+		const float* Y() const;
+		const float* Z() const;
+
+		// Element-wise versions of the Mat4 and Vec3 operations, out is resized
+		// to the size of this array and may be this array itself
+		void TransformPoints( const Mat4& mat, Vec3Array& out ) const;
+		void TransformDirections( const Mat4& mat, Vec3Array& out ) const;
+		void Cross( const Vec3Array& v, Vec3Array& out ) const;
+		void Normal( Vec3Array& out ) const;
+
+		// These write Count() floats to out, v needs at least as many vectors
+		void Dot( const Vec3Array& v, float* out ) const;
+		void Length( float* out ) const;
+
+	private:
+		std::vector<float, Internal::alignedAllocator<float> > data;
+		size_t count, stride;
+
+		void transform( const Mat4& mat, float w, Vec3Array& out ) const;
+		void clearPadding();
+	};
+
+	inline Vec3Array::Vec3Array( size_t count ) : count( 0 ), stride( 0 )
+	{
+		Resize( count );
+	}
+
+	inline Vec3Array::Vec3Array( const Vec3* v, size_t count ) : count( 0 ), stride( 0 )
+	{
+		Assign( v, count );
+	}
+
+	inline size_t Vec3Array::Count() const
+	{
+		return count;
+	}
+
+	inline void Vec3Array::Resize( size_t count )
+	{
+		size_t stride = ( count + 7 ) & ~(size_t)7;
+		size_t previous = this->count;
+		this->count = count;
+
+		if ( stride != this->stride ) {
+			std::vector<float, Internal::alignedAllocator<float> > resized( stride * 3 );
+			size_t kept = count < previous ? count : previous;
+
+			for ( int k = 0; k < 3 && kept > 0; k++ )
+				memcpy( &resized[k * stride], &data[k * this->stride], kept * sizeof( float ) );
+
+			data.swap( resized );
+			this->stride = stride;
+		} else if ( count < previous ) {
+			// Keep the padding zero, so growing again gives zero vectors
+			clearPadding();
+		}
+	}
+
+	inline void Vec3Array::clearPadding()
+	{
+		if ( count == stride ) return;
+
+		for ( int k = 0; k < 3; k++ )
+			memset( &data[k * stride + count], 0, ( stride - count ) * sizeof( float ) );
+	}
+
+	inline void Vec3Array::Assign( const Vec3* v, size_t count )
+	{
+		Resize( count );
+		float* x = X();
+		float* y = Y();
+		float* z = Z();
+		size_t i = 0;
+
+#if defined( OOGL_SIMD_SSE2 )
+		// Four vectors are loaded as a 4x3 block and transposed into the streams
+		const float* src = (const float*)v;
+		for ( ; i + 4 <= count; i += 4, src += 12 )
+		{
+			__m128 p0 = _mm_loadu_ps( src );
+			__m128 p1 = _mm_loadu_ps( src + 3 );
+			__m128 p2 = _mm_loadu_ps( src + 6 );
+			__m128 p3 = _mm_movelh_ps( _mm_loadl_pi( _mm_setzero_ps(), (const __m64*)( src + 9 ) ), _mm_load_ss( src + 11 ) );
+			_MM_TRANSPOSE4_PS( p0, p1, p2, p3 );
+			_mm_store_ps( x + i, p0 );
+			_mm_store_ps( y + i, p1 );
+			_mm_store_ps( z + i, p2 );
+		}
+#elif defined( OOGL_SIMD_NEON )
+		const float* src = (const float*)v;
+		for ( ; i + 4 <= count; i += 4, src += 12 )
+		{
+			float32x4x3_t p = vld3q_f32( src );
+			vst1q_f32( x + i, p.val[0] );
+			vst1q_f32( y + i, p.val[1] );
+			vst1q_f32( z + i, p.val[2] );
+		}
+#endif
+
+		for ( ; i < count; i++ )
+		{
+			x[i] = v[i].X;
+			y[i] = v[i].Y;
+			z[i] = v[i].Z;
+		}
+	}
+
+	inline void Vec3Array::CopyTo( Vec3* out ) const
+	{
+		const float* x = X();
+		const float* y = Y();
+		const float* z = Z();
+		size_t i = 0;
+
+#if defined( OOGL_SIMD_SSE2 )
+		float* dst = (float*)out;
+		for ( ; i + 4 <= count; i += 4, dst += 12 )
+		{
+			__m128 p0 = _mm_load_ps( x + i );
+			__m128 p1 = _mm_load_ps( y + i );
+			__m128 p2 = _mm_load_ps( z + i );
+			__m128 p3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS( p0, p1, p2, p3 );
+
+			// Every row is stored as four floats, the last one is overwritten by the next row
+			_mm_storeu_ps( dst, p0 );
+			_mm_storeu_ps( dst + 3, p1 );
+			_mm_storeu_ps( dst + 6, p2 );
+			_mm_storel_pi( (__m64*)( dst + 9 ), p3 );
+			_mm_store_ss( dst + 11, _mm_movehl_ps( p3, p3 ) );
+		}
+#elif defined( OOGL_SIMD_NEON )
+		float* dst = (float*)out;
+		for ( ; i + 4 <= count; i += 4, dst += 12 )
+		{
+			float32x4x3_t p;
+			p.val[0] = vld1q_f32( x + i );
+			p.val[1] = vld1q_f32( y + i );
+			p.val[2] = vld1q_f32( z + i );
+			vst3q_f32( dst, p );
+		}
+#endif
+
+		for ( ; i < count; i++ )
+			out[i] = Vec3( x[i], y[i], z[i] );
+	}
+
+	inline Vec3 Vec3Array::Get( size_t i ) const
+	{
+		return Vec3( X()[i], Y()[i], Z()[i] );
+	}
+
+	inline void Vec3Array::Set( size_t i, const Vec3& v )
+	{
+		X()[i] = v.X;
+		Y()[i] = v.Y;
+		Z()[i] = v.Z;
+	}
+
+	inline float* Vec3Array::X() { return data.empty() ? 0 : &data[0]; }
+	inline float* Vec3Array::Y() { return data.empty() ? 0 : &data[stride]; }
+	inline float* Vec3Array::Z() { return data.empty() ? 0 : &data[stride * 2]; }
+	inline const float* Vec3Array::X() const { return data.empty() ? 0 : &data[0]; }
+	inline const float* Vec3Array::Y() const { return data.empty() ? 0 : &data[stride]; }
+	inline const float* Vec3Array::Z() const { return data.empty() ? 0 : &data[stride * 2]; }
+
+	inline void Vec3Array::transform( const Mat4& mat, float w, Vec3Array& out ) const
+	{
+		using namespace Internal;
+
+		out.Resize( count );
+
+		const float* m = mat.m;
+		lanes m0 = splatLanes( m[0] ), m4 = splatLanes( m[4] ), m8 = splatLanes( m[8] ), m12 = splatLanes( m[12] * w );
+		lanes m1 = splatLanes( m[1] ), m5 = splatLanes( m[5] ), m9 = splatLanes( m[9] ), m13 = splatLanes( m[13] * w );
+		lanes m2 = splatLanes( m[2] ), m6 = splatLanes( m[6] ), m10 = splatLanes( m[10] ), m14 = splatLanes( m[14] * w );
+
+		const float* x = X();
+		const float* y = Y();
+		const float* z = Z();
+		float* ox = out.X();
+		float* oy = out.Y();
+		float* oz = out.Z();
+
+		for ( size_t i = 0; i < stride; i += lanes::Count )
+		{
+			lanes px = loadLanes( x + i ), py = loadLanes( y + i ), pz = loadLanes( z + i );
+			storeLanes( ox + i, m0 * px + m4 * py + m8 * pz + m12 );
+			storeLanes( oy + i, m1 * px + m5 * py + m9 * pz + m13 );
+			storeLanes( oz + i, m2 * px + m6 * py + m10 * pz + m14 );
+		}
+	}
+
+	inline void Vec3Array::TransformPoints( const Mat4& mat, Vec3Array& out ) const
+	{
+		transform( mat, 1.0f, out );
+	}
+
+	inline void Vec3Array::TransformDirections( const Mat4& mat, Vec3Array& out ) const
+	{
+		transform( mat, 0.0f, out );
+	}
+
+	inline void Vec3Array::Cross( const Vec3Array& v, Vec3Array& out ) const
+	{
+		using namespace Internal;
+
+		// Resizing keeps the first count vectors, so out may also be v
+		out.Resize( count );
+
+		const float *ax = X(), *ay = Y(), *az = Z();
+		const float *bx = v.X(), *by = v.Y(), *bz = v.Z();
+		float *ox = out.X(), *oy = out.Y(), *oz = out.Z();
+
+		for ( size_t i = 0; i < stride; i += lanes::Count )
+		{
+			lanes x = loadLanes( ax + i ), y = loadLanes( ay + i ), z = loadLanes( az + i );
+			lanes vx = loadLanes( bx + i ), vy = loadLanes( by + i ), vz = loadLanes( bz + i );
+			storeLanes( ox + i, y * vz - z * vy );
+			storeLanes( oy + i, z * vx - x * vz );
+			storeLanes( oz + i, x * vy - y * vx );
+		}
+	}
+
+	inline void Vec3Array::Normal( Vec3Array& out ) const
+	{
+		using namespace Internal;
+
+		out.Resize( count );
+
+		const float* x = X();
+		const float* y = Y();
+		const float* z = Z();
+		float* ox = out.X();
+		float* oy = out.Y();
+		float* oz = out.Z();
+
+		// The zero padding gives NaN, so it is cleared again afterwards
+		for ( size_t i = 0; i < stride; i += lanes::Count )
+		{
+			lanes px = loadLanes( x + i ), py = loadLanes( y + i ), pz = loadLanes( z + i );
+#if defined( OOGL_FAST_MATH )
+			lanes scale = rsqrtLanes( px * px + py * py + pz * pz );
+			storeLanes( ox + i, px * scale );
+			storeLanes( oy + i, py * scale );
+			storeLanes( oz + i, pz * scale );
+#else
+			lanes length = sqrtLanes( px * px + py * py + pz * pz );
+			storeLanes( ox + i, px / length );
+			storeLanes( oy + i, py / length );
+			storeLanes( oz + i, pz / length );
+#endif
+		}
+
+		out.clearPadding();
+	}
+
+	inline void Vec3Array::Dot( const Vec3Array& v, float* out ) const
+	{
+		using namespace Internal;
+
+		const float *ax = X(), *ay = Y(), *az = Z();
+		const float *bx = v.X(), *by = v.Y(), *bz = v.Z();
+
+		for ( size_t i = 0; i < count; i += lanes::Count )
+		{
+			lanes d = loadLanes( ax + i ) * loadLanes( bx + i ) + loadLanes( ay + i ) * loadLanes( by + i ) + loadLanes( az + i ) * loadLanes( bz + i );
+
+			if ( i + lanes::Count <= count )
+				storeLanesUnaligned( out + i, d );
+			else
+				storeLanesPartial( out + i, d, count - i );
+		}
+	}
+
+	inline void Vec3Array::Length( float* out ) const
+	{
+		using namespace Internal;
+
+		const float* x = X();
+		const float* y = Y();
+		const float* z = Z();
+
+		for ( size_t i = 0; i < count; i += lanes::Count )
+		{
+			lanes px = loadLanes( x + i ), py = loadLanes( y + i ), pz = loadLanes( z + i );
+			lanes length = sqrtLanes( px * px + py * py + pz * pz );
+
+			if ( i + lanes::Count <= count )
+				storeLanesUnaligned( out + i, length );
+			else
+				storeLanesPartial( out + i, length, count - i );
+		}
+	}
+}
+
+#endif
\ No newline at end of file
@@ -24,6 +24,7 @@
 #ifndef OOGL_VEC4_HPP
 #define OOGL_VEC4_HPP
 
+#include <GL/Math/Util.hpp>
 #include <GL/Math/Vec3.hpp>
 
 namespace GL
@@ -34,23 +35,71 @@ namespace GL
 	class Vec4
 	{
 	public:
-		Vec4( float x = 0.0f, float y = 0.0f, float z = 0.0f, float w = 1.0f ) : X( x ), Y( y ), Z( z ), W( w ) {}
-		Vec4( const Vec3& v, float w = 1.0f ) : X( v.X ), Y( v.Y ), Z( v.Z ), W( w ) {}
+		OOGL_CONSTEXPR Vec4( float x = 0.0f, float y = 0.0f, float z = 0.0f, float w = 1.0f ) : X( x ), Y( y ), Z( z ), W( w ) {}
+		OOGL_CONSTEXPR Vec4( const Vec3& v, float w = 1.0f ) : X( v.X ), Y( v.Y ), Z( v.Z ), W( w ) {}
 
 		Vec4& operator+=( const Vec4& v );
 		Vec4& operator-=( const Vec4& v );
 
-		const Vec4 operator+( const Vec4& v ) const;
-		const Vec4 operator-( const Vec4& v ) const;
+		OOGL_CONSTEXPR const Vec4 operator+( const Vec4& v ) const;
+		OOGL_CONSTEXPR const Vec4 operator-( const Vec4& v ) const;
 
-		friend Vec4 operator*( const Vec4& v, float n );
-		friend Vec4 operator*( float n, const Vec4& v );
+		friend OOGL_CONSTEXPR Vec4 operator*( const Vec4& v, float n );
+		friend OOGL_CONSTEXPR Vec4 operator*( float n, const Vec4& v );
 
-		friend Vec4 operator/( const Vec4& v, float n );
-		friend Vec4 operator/( float n, const Vec4& v );
+		friend OOGL_CONSTEXPR Vec4 operator/( const Vec4& v, float n );
+		friend OOGL_CONSTEXPR Vec4 operator/( float n, const Vec4& v );
 
 		float X, Y, Z, W;
 	};
+
+	inline Vec4& Vec4::operator+=( const Vec4& v )
+	{
+		X += v.X;
+		Y += v.Y;
+		Z += v.Z;
+		W += v.W;
+		return *this;
+	}
+
+	inline Vec4& Vec4::operator-=( const Vec4& v )
+	{
+		X -= v.X;
+		Y -= v.Y;
+		Z -= v.Z;
+		W -= v.W;
+		return *this;
+	}
+
+	inline OOGL_CONSTEXPR const Vec4 Vec4::operator+( const Vec4& v ) const
+	{
+		return Vec4( X + v.X, Y + v.Y, Z + v.Z, W + v.W );
+	}
+
+	inline OOGL_CONSTEXPR const Vec4 Vec4::operator-( const Vec4& v ) const
+	{
+		return Vec4( X - v.X, Y - v.Y, Z - v.Z, W - v.W );
+	}
+
+	inline OOGL_CONSTEXPR Vec4 operator*( const Vec4& v, float n )
+	{
+		return Vec4( v.X * n, v.Y * n, v.Z * n, v.W * n );
+	}
+
+	inline OOGL_CONSTEXPR Vec4 operator*( float n, const Vec4& v )
+	{
+		return Vec4( v.X * n, v.Y * n, v.Z * n, v.W * n );
+	}
+
+	inline OOGL_CONSTEXPR Vec4 operator/( const Vec4& v, float n )
+	{
+		return Vec4( v.X / n, v.Y / n, v.Z / n, v.W / n );
+	}
+
+	inline OOGL_CONSTEXPR Vec4 operator/( float n, const Vec4& v )
+	{
+		return Vec4( v.X / n, v.Y / n, v.Z / n, v.W / n );
+	}
 }
 
 #endif
\ No newline at end of file
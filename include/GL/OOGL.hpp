@@ -37,8 +37,17 @@
 #include <GL/Math/Vec2.hpp>
 #include <GL/Math/Vec3.hpp>
 #include <GL/Math/Vec4.hpp>
+#include <GL/Math/Vec3Array.hpp>
 #include <GL/Math/Mat3.hpp>
 #include <GL/Math/Mat4.hpp>
+#include <GL/Math/Quat.hpp>
+#include <GL/Math/DualQuat.hpp>
+#include <GL/Math/Transform.hpp>
+#include <GL/Math/AABB.hpp>
+#include <GL/Math/Sphere.hpp>
+#include <GL/Math/Plane.hpp>
+#include <GL/Math/Frustum.hpp>
+#include <GL/Math/Ray.hpp>
 #include <GL/Math/Util.hpp>
 
 /*
@@ -68,5 +77,9 @@
 #include <GL/Util/Color.hpp>
 #include <GL/Util/Image.hpp>
 #include <GL/Util/Mesh.hpp>
+#include <GL/Util/MeshLOD.hpp>
+#include <GL/Util/BVH.hpp>
+#include <GL/Util/StaticBatch.hpp>
+#include <GL/Util/AssetLoader.hpp>
 
 #endif
\ No newline at end of file
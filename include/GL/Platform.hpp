@@ -43,10 +43,20 @@
 	#define OOGL_PLATFORM_OSX
 #endif
 
+/*
+	SIMD instruction set identification
+*/
+
+#include <GL/SIMD.hpp>
+
 /*
 	Types
 */
 
+#define GL_HALF_FLOAT 0x140B
+#define GL_INT_2_10_10_10_REV 0x8D9F
+#define GL_UNSIGNED_INT_2_10_10_10_REV 0x8368
+
 namespace GL
 {
 	typedef unsigned char uchar;
@@ -65,7 +75,11 @@ namespace GL
 			Int = GL_INT,
 			UnsignedInt = GL_UNSIGNED_INT,
 			Float = GL_FLOAT,
-			Double = GL_DOUBLE
+			Double = GL_DOUBLE,
+
+			HalfFloat = GL_HALF_FLOAT,
+			Int2101010Rev = GL_INT_2_10_10_10_REV,
+			UnsignedInt2101010Rev = GL_UNSIGNED_INT_2_10_10_10_REV
 		};
 	}
 
@@ -0,0 +1,174 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_ASSETLOADER_HPP
+#define OOGL_ASSETLOADER_HPP
+
+#include <GL/Platform.hpp>
+#include <GL/Util/Mesh.hpp>
+#include <GL/Util/Image.hpp>
+#include <GL/GL/VertexBuffer.hpp>
+#include <GL/GL/Texture.hpp>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <future>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace GL
+{
+	/*
+		Buffers created from a mesh by AssetLoader::QueueMeshBuffers
+	*/
+	struct MeshBuffers
+	{
+		std::shared_ptr<const Mesh> Source;
+		VertexBuffer Vertices;
+
+		// Only created for indexed meshes
+		VertexBuffer Indices;
+	};
+
+	/*
+		Background loader for meshes and images
+
+		Files are parsed and decoded into CPU memory by a pool of worker
+		threads. Work that needs the GL context, like creating buffers and
+		textures, is queued until the thread that owns the context calls
+		Update, which runs as much of it as fits in a time budget so a level
+		can stream in without stalling a frame.
+
+		Every load returns a future that becomes ready once the asset is
+		completely done, or that rethrows the exception the load failed with.
+	*/
+	class AssetLoader
+	{
+	public:
+		// Starts the given number of worker threads, or one less than the
+		// number of hardware threads if 0, leaving a core to the render thread
+		AssetLoader( uint threads = 0 );
+
+		// Drops loads that have not started and waits for the running ones,
+		// the futures of dropped loads throw std::future_error
+		~AssetLoader();
+
+		std::shared_future<std::shared_ptr<const Mesh>> QueueMesh( const std::string& filename, MeshOptions::mesh_options_t options = MeshOptions::Base );
+		std::shared_future<std::shared_ptr<const Image>> QueueImage( const std::string& filename );
+
+		// Loads the mesh in the background and calls upload with it from Update
+		std::shared_future<std::shared_ptr<const Mesh>> QueueMesh( const std::string& filename, MeshOptions::mesh_options_t options, std::function<void ( const Mesh& mesh )> upload );
+		std::shared_future<std::shared_ptr<const Image>> QueueImage( const std::string& filename, std::function<void ( const Image& image )> upload );
+
+		// Creates the buffers from Update, with the vertex data written by
+		// f( const Vertex& v, VertexDataBuffer& data ) as in VertexBuffer
+		template <typename F>
+		std::shared_future<MeshBuffers> QueueMeshBuffers( const std::string& filename, MeshOptions::mesh_options_t options, BufferUsage::buffer_usage_t usage, F f );
+
+		std::shared_future<Texture> QueueTexture( const std::string& filename, InternalFormat::internal_format_t internalFormat = InternalFormat::RGBA, bool mipmaps = true );
+
+		// Runs queued GL work on the calling thread until budget seconds have
+		// passed and returns the number of assets finished. A single upload
+		// is never interrupted and at least one is run per call, so an asset
+		// larger than the budget still finishes.
+		uint Update( float budget );
+
+		// Number of loads whose futures are not ready yet
+		uint Pending() const;
+
+	private:
+		std::vector<std::thread> workers;
+		std::deque<std::function<void ()>> jobs;
+		std::deque<std::function<void ()>> uploads;
+		mutable std::mutex mutex;
+		std::condition_variable jobAvailable;
+		uint pending;
+		bool stopping;
+
+		AssetLoader( const AssetLoader& );
+		const AssetLoader& operator=( const AssetLoader& );
+
+		void Work();
+		void Enqueue( std::function<void ()> job );
+		void EnqueueUpload( std::function<void ()> upload );
+		void Finish();
+
+		// Runs load on a worker and fulfils the promise right away
+		template <typename T>
+		std::shared_future<std::shared_ptr<const T>> Load( std::function<std::shared_ptr<const T> ()> load );
+
+		// Runs load on a worker and then upload( result ) from Update, the
+		// promise is fulfilled with the return value of upload
+		template <typename T, typename R>
+		std::shared_future<R> Queue( std::function<std::shared_ptr<const T> ()> load, std::function<R ( const std::shared_ptr<const T>& asset )> upload );
+	};
+
+	template <typename F>
+	std::shared_future<MeshBuffers> AssetLoader::QueueMeshBuffers( const std::string& filename, MeshOptions::mesh_options_t options, BufferUsage::buffer_usage_t usage, F f )
+	{
+		return Queue<Mesh, MeshBuffers>(
+			[filename, options]() { return std::shared_ptr<const Mesh>( new Mesh( filename, options ) ); },
+			[usage, f]( const std::shared_ptr<const Mesh>& mesh ) {
+				MeshBuffers buffers;
+				buffers.Source = mesh;
+				buffers.Vertices = VertexBuffer( *mesh, usage, f );
+				if ( mesh->IsIndexed() ) buffers.Indices = VertexBuffer( *mesh, usage );
+				return buffers;
+			}
+		);
+	}
+
+	template <typename T, typename R>
+	std::shared_future<R> AssetLoader::Queue( std::function<std::shared_ptr<const T> ()> load, std::function<R ( const std::shared_ptr<const T>& asset )> upload )
+	{
+		// std::function needs copyable targets, so the promise is shared
+		std::shared_ptr<std::promise<R>> promise( new std::promise<R>() );
+		std::shared_future<R> future = promise->get_future().share();
+
+		Enqueue( [this, promise, load, upload]() {
+			std::shared_ptr<const T> asset;
+			try {
+				asset = load();
+			} catch ( ... ) {
+				promise->set_exception( std::current_exception() );
+				Finish();
+				return;
+			}
+
+			EnqueueUpload( [promise, upload, asset]() {
+				try {
+					promise->set_value( upload( asset ) );
+				} catch ( ... ) {
+					promise->set_exception( std::current_exception() );
+				}
+			} );
+		} );
+
+		return future;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_BVH_HPP
+#define OOGL_BVH_HPP
+
+#include <GL/Util/Mesh.hpp>
+#include <GL/Math/AABB.hpp>
+#include <GL/Math/Ray.hpp>
+#include <GL/Math/Frustum.hpp>
+#include <vector>
+#include <cfloat>
+
+namespace GL
+{
+	/*
+		Closest intersection of a ray with a triangle
+	*/
+	struct RayHit
+	{
+		uint Triangle;
+		float Distance;
+
+		// Barycentric coordinates of the second and third vertex of the triangle
+		float U, V;
+	};
+
+	/*
+		Bounding volume hierarchy over the triangles of a mesh
+
+		The tree is built with binned SAH (surface area heuristic) splits, with
+		large subtrees built on separate threads. Triangles are identified by
+		their position in the mesh, i.e. vertices 3i to 3i+2 or the vertices
+		referred to by indices 3i to 3i+2 for indexed meshes.
+	*/
+	class BVH
+	{
+	public:
+		BVH( const Mesh& mesh, uint maxLeafSize = 4 );
+
+		const AABB& Bounds() const;
+		int NodeCount() const;
+
+		// Finds the closest triangle hit by the ray within maxDistance
+		bool Intersect( const Ray& ray, RayHit& hit, float maxDistance = FLT_MAX ) const;
+
+		// Appends the triangles whose bounds intersect the frustum
+		void Query( const Frustum& frustum, std::vector<uint>& triangles ) const;
+
+	private:
+		// Interior nodes have their children at left and left + 1, all nodes
+		// cover the triangles first to first + count of the triangle list
+		struct node
+		{
+			AABB bounds;
+			uint left, first, count;
+		};
+
+		struct buildContext;
+
+		std::vector<node> nodes;
+		std::vector<uint> triangles;
+		std::vector<Vec3> positions;
+
+		void Build( buildContext& context, uint index, uint first, uint count, int depth );
+	};
+}
+
+#endif
\ No newline at end of file
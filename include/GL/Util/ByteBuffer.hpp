@@ -36,15 +36,17 @@ namespace GL
 	class ByteReader
 	{
 	public:
-		ByteReader( uint length, bool littleEndian ) : buffer( new uchar[length] ), length( length ), ptr( 0 ), littleEndian( littleEndian ) {}
-		~ByteReader() { delete [] buffer; }
+		ByteReader( uint length, bool littleEndian ) : buffer( new uchar[length] ), length( length ), ptr( 0 ), littleEndian( littleEndian ), owned( true ) {}
+		ByteReader( const uchar* data, uint length, bool littleEndian ) : buffer( (uchar*)data ), length( length ), ptr( 0 ), littleEndian( littleEndian ), owned( false ) {}
+		~ByteReader() { if ( owned ) delete [] buffer; }
 
 		void Reuse( uint length )
 		{
-			delete [] buffer;
+			if ( owned ) delete [] buffer;
 			buffer = new uchar[length];
 			this->length = length;
 			ptr = 0;
+			owned = true;
 		}
 
 		uchar* Data() { return buffer; }
@@ -55,7 +57,7 @@ namespace GL
 
 		bool Compare( uint location, uint length, const uchar* data )
 		{
-			if ( location + length > this->length ) return false;
+			if ( location > this->length || length > this->length - location ) return false;
 			
 			for ( uint i = 0; i < length; i++ )
 				if ( buffer[ location + i ] != data[i] ) return false;
@@ -111,6 +113,7 @@ namespace GL
 		uint length;
 		uint ptr;
 		bool littleEndian;
+		bool owned;
 
 		ByteReader( const ByteReader& );
 		const ByteReader& operator=( const ByteReader& );
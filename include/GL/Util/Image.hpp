@@ -96,6 +96,8 @@ namespace GL
 
 		Image( const Image& );
 		const Image& operator=( const Image& );
+
+		void Load( ByteReader& data );
 		
 		void LoadBMP( ByteReader& data );
 		void SaveBMP( const std::string& filename );
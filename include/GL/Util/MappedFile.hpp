@@ -0,0 +1,68 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_MAPPEDFILE_HPP
+#define OOGL_MAPPEDFILE_HPP
+
+#include <GL/Platform.hpp>
+#include <GL/Util/Image.hpp>
+#include <string>
+#include <vector>
+
+namespace GL
+{
+	/*
+		Read-only view of a file's contents
+
+		The file is memory-mapped where the platform supports it, so it can
+		be parsed straight from the page cache without copying. Otherwise
+		the contents are read into a buffer.
+	*/
+	class MappedFile
+	{
+	public:
+		MappedFile( const std::string& filename );
+		~MappedFile();
+
+		const uchar* Data() const;
+		size_t Length() const;
+
+	private:
+		const uchar* data;
+		size_t length;
+		bool mapped;
+		std::vector<uchar> buffer;
+
+#if defined( OOGL_PLATFORM_WINDOWS )
+		HANDLE file;
+		HANDLE mapping;
+#endif
+
+		void Read( const std::string& filename );
+
+		MappedFile( const MappedFile& );
+		const MappedFile& operator=( const MappedFile& );
+	};
+}
+
+#endif
\ No newline at end of file
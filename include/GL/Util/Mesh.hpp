@@ -27,10 +27,64 @@
 #include <GL/Util/Image.hpp>
 #include <GL/Math/Vec3.hpp>
 #include <GL/Math/Vec2.hpp>
+#include <GL/Math/Vec4.hpp>
+#include <GL/Math/AABB.hpp>
+#include <GL/Math/Sphere.hpp>
 #include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
 
 namespace GL
 {
+	/*
+		Mesh loading options
+
+		Parallel splits large files at line boundaries and parses the
+		chunks on all available cores (or as many threads as given to the
+		constructor), with results identical to serial
+
+		Cache stores the loaded mesh in binary form next to the source file
+		(<filename>.cache) and loads that instead on subsequent runs, for as
+		long as the size and modification time of the source file match
+		(changes to its material libraries are not detected)
+
+		Optimize runs Mesh::Optimize on indexed meshes after loading
+
+		Clusters runs Mesh::BuildClusters with the default limits after loading
+
+		Tangents runs Mesh::ComputeTangents after loading
+	*/
+	namespace MeshOptions
+	{
+		enum mesh_options_t
+		{
+			Base = 0,
+			Indexed = 1,
+			Parallel = 2,
+			Cache = 4,
+			Optimize = 8,
+			Clusters = 16,
+			Tangents = 32
+		};
+
+		inline mesh_options_t operator|( mesh_options_t lft, mesh_options_t rht )
+		{
+			return (mesh_options_t)( (int)lft | (int)rht );
+		}
+	}
+
+	/*
+		Exceptions
+	*/
+	class MeshFormatException : public std::exception
+	{
+		virtual const char* what() const throw()
+		{
+			return "Mesh file format not supported!";
+		}
+	};
+
 	/*
 		Internal vertex class
 	*/
@@ -41,19 +95,181 @@ namespace GL
 		Vec3 Normal;
 	};
 
+	/*
+		Post-transform vertex cache efficiency of a mesh, ACMR is the amount of
+		vertex shader invocations per triangle and ATVR per unique vertex
+	*/
+	struct MeshCacheStats
+	{
+		float ACMR;
+		float ATVR;
+	};
+
+	/*
+		Material from an MTL library, maps are indices into Mesh::Texture or -1
+		if the material doesn't have them
+
+		Materials that are used but not defined in any library get the defaults,
+		which is a white diffuse color without any maps
+	*/
+	struct MeshMaterial
+	{
+		std::string Name;
+		Vec3 Ambient, Diffuse, Specular;
+		float Shininess;
+		float Opacity;
+		int DiffuseMap, SpecularMap, NormalMap, AlphaMap;
+
+		// Material with the defaults
+		MeshMaterial( const std::string& name = "" );
+	};
+
+	/*
+		Range of triangles with the same material, in indices for indexed meshes
+		and in vertices otherwise
+	*/
+	struct MeshSubmesh
+	{
+		uint Material;
+		uint Start;
+		uint Count;
+	};
+
+	/*
+		Group of neighbouring triangles, drawn as TriangleCount * 3 indices of
+		Mesh::ClusterIndices starting at IndexOffset
+
+		The normal cone contains the normals of all triangles in the cluster,
+		so every one of them faces away from a viewer IsBackfacing is true for
+	*/
+	struct MeshCluster
+	{
+		uint IndexOffset;
+		uint TriangleCount;
+		AABB Bounds;
+		Sphere BoundingSphere;
+		Vec3 ConeAxis;
+		float ConeCutoff;
+
+		bool IsBackfacing( const Vec3& viewer ) const;
+	};
+
 	/*
 		3D mesh container
 	*/
 	class Mesh
 	{
 	public:
-		Mesh( const std::string& filename );
+		// Faces without normals get smooth normals that are averaged over the
+		// faces around the same position, except across edges sharper than
+		// creaseAngle (in radians, 60 degrees by default)
+		// MeshOptions::Parallel parses with up to threads threads, 0 uses all cores
+		Mesh( const std::string& filename, MeshOptions::mesh_options_t options = MeshOptions::Base, float creaseAngle = 1.0471976f, uint threads = 0 );
 
 		const Vertex* Vertices() const;
 		int VertexCount() const;
 
+		// Bounds of the vertex positions, computed when the mesh is loaded
+		const AABB& Bounds() const;
+		const Sphere& BoundingSphere() const;
+
+		// Files that use materials are sorted to have one submesh per material,
+		// triangles without a material use a default one with an empty name
+		const MeshMaterial* Materials() const;
+		int MaterialCount() const;
+		const MeshSubmesh* Submeshes() const;
+		int SubmeshCount() const;
+
+		// Texture paths used by the materials, relative to the working directory
+		// and with every file only listed once
+		const std::string& Texture( int index ) const;
+		int TextureCount() const;
+
+		// Texture coordinates not present in the file are zero in every vertex,
+		// meshes with generated normals count as having normals
+		bool HasTexCoords() const;
+		bool HasNormals() const;
+
+		// Computes a MikkTSpace-like tangent for every vertex, with the bitangent
+		// sign in W, so bitangent = W * cross( normal, tangent ). Like MikkTSpace,
+		// triangle tangents are projected onto the normal plane and weighted by
+		// corner angle, vertices with equal attributes share their tangent and
+		// indexed vertices used by mirrored texture coordinates are split and the
+		// copies appended. Unlike MikkTSpace, the corners of a vertex are not
+		// further grouped by how far their tangent frames diverge and degenerate
+		// triangles are simply skipped, so results are close to but not bit-for-bit
+		// the same as those of tools that bake normal maps with MikkTSpace.
+		// Meshes without normals use the averaged face normals instead and
+		// vertices without usable texture coordinates get any perpendicular tangent.
+		void ComputeTangents();
+		bool HasTangents() const;
+		const Vec4* Tangents() const;
+
+		// Indexed meshes store every unique vertex once and describe the
+		// triangles with an index array, suitable for Context::DrawElements
+		bool IsIndexed() const;
+		const uint* Indices() const;
+		int IndexCount() const;
+
+		// Smallest index type that can address all vertices, which is the
+		// type used by index buffers created from this mesh
+		Type::type_t IndexType() const;
+
+		// Reorders the triangles within each submesh for vertex cache reuse and
+		// then the vertices in the order they are first used, only affects
+		// indexed meshes
+		void Optimize();
+		MeshCacheStats CacheStats( uint cacheSize = 32 ) const;
+
+		// Splits the triangles into clusters of at most maxVertices unique vertices
+		// and maxTriangles triangles with their own index array, which refers to
+		// the same vertices as Indices and can be culled per cluster on the CPU.
+		// Clusters don't cross submeshes and are stored in the same order.
+		void BuildClusters( uint maxVertices = 64, uint maxTriangles = 124 );
+		const MeshCluster* Clusters() const;
+		int ClusterCount() const;
+		const uint* ClusterIndices() const;
+		int ClusterIndexCount() const;
+
+		// Compact binary format with 64 byte aligned sections that is loaded
+		// without any parsing. The file is mapped and its sections are copied
+		// into the mesh, which owns its data like any other mesh, so loading
+		// costs one copy of the file and the mapping is closed afterwards.
+		void SaveBinary( const std::string& filename ) const;
+		static Mesh LoadBinary( const std::string& filename );
+
+		// Reads an OBJ file in fixed-size windows and passes the triangle
+		// vertices to the sink in batches of at most batchSize, missing normals
+		// are left zero. Only the file text and the assembled vertices are
+		// bounded: faces may refer to any earlier v, vt and vn line, so those
+		// are all kept and memory grows with the number of them.
+		static void Stream( const std::string& filename, std::function<void ( const Vertex* vertices, uint count )> sink, uint batchSize = 4096 );
+
 	private:
+		friend class StaticBatch;
+
 		std::vector<Vertex> vertices;
+		std::vector<uint> indices;
+		std::vector<MeshCluster> clusters;
+		std::vector<uint> clusterIndices;
+		std::vector<MeshMaterial> materials;
+		std::vector<MeshSubmesh> submeshes;
+		std::vector<std::string> textures;
+		std::vector<Vec4> tangents;
+		bool indexed, optimized, clustered;
+		bool hasTexCoords, hasNormals, hasTangents;
+		float creaseAngle;
+		AABB bounds;
+		Sphere boundingSphere;
+
+		Mesh();
+
+		void Parse( const std::string& filename, MeshOptions::mesh_options_t options, uint threads );
+		void ComputeBounds();
+		void LoadMaterials( const std::string& filename, const std::vector<std::string>& libraries, const std::vector<std::string>& names );
+
+		bool ReadBinary( const std::string& filename, bool checkSource, uint64_t sourceSize, uint64_t sourceTime );
+		void WriteBinary( const std::string& filename, uint64_t sourceSize, uint64_t sourceTime ) const;
 	};
 }
 
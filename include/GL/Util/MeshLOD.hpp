@@ -0,0 +1,75 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_MESHLOD_HPP
+#define OOGL_MESHLOD_HPP
+
+#include <GL/Util/Mesh.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <vector>
+
+namespace GL
+{
+	/*
+		Chain of simplified index buffers for a mesh
+
+		Every level is derived from the previous one by collapsing edges in
+		order of their quadric error, where a vertex is always moved onto one
+		of its neighbours. The levels therefore keep using the vertices of the
+		original mesh and can be drawn from the same vertex buffer with their
+		own element buffer. Level 0 is the original mesh.
+	*/
+	class MeshLOD
+	{
+	public:
+		// Builds levels with ratio, ratio^2, ... of the original triangle count
+		MeshLOD( const Mesh& mesh, int levels = 4, float ratio = 0.5f );
+
+		// Builds a level for every ratio of the original triangle count, in decreasing order
+		MeshLOD( const Mesh& mesh, const float ratios[], int count );
+
+		int LevelCount() const;
+		const uint* Indices( int level ) const;
+		int IndexCount( int level ) const;
+
+		// Approximate largest distance between the simplified and original surface, in object space
+		float Error( int level ) const;
+
+		// Coarsest level whose error is at most maxPixelError pixels on screen when
+		// the mesh is drawn at the given distance from the camera with projection proj
+		int SelectLevel( const Mat4& proj, float distance, float viewportHeight, float maxPixelError = 1.0f ) const;
+
+	private:
+		struct level
+		{
+			std::vector<uint> indices;
+			float error;
+		};
+
+		std::vector<level> levels;
+
+		void Build( const Mesh& mesh, const float ratios[], int count );
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_NUMBERSCANNER_HPP
+#define OOGL_NUMBERSCANNER_HPP
+
+#include <string>
+#include <algorithm>
+#include <sstream>
+#include <locale>
+#include <limits>
+#include <climits>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+namespace GL
+{
+	namespace Internal
+	{
+		/*
+			Number scanning
+
+			Digits are accumulated into a 64-bit integer in the same pass that finds
+			the end of the number, as the numbers in OBJ files are too short for a
+			vector search of the digits to pay off (see samples/ParserBenchmark).
+			Floats are rounded correctly: exact single or double precision
+			arithmetic is used where it is guaranteed to round correctly, which
+			covers nearly all numbers found in practice, and the remaining numbers
+			are handed to the C++ library.
+
+			Used by the OBJ parser, kept in a header so the samples can measure it.
+		*/
+		inline void accumulateDigits( const char* p, const char* end, bool fraction, uint64_t& mantissa, int& significant, int& exponent, bool& truncated )
+		{
+			// Up to 19 significant digits always fit in 64 bits
+			for ( ; p < end; p++ )
+			{
+				unsigned int d = *p - '0';
+
+				if ( significant < 19 ) {
+					if ( mantissa != 0 || d != 0 ) {
+						mantissa = mantissa * 10 + d;
+						significant++;
+					}
+					if ( fraction ) exponent--;
+				} else {
+					if ( d != 0 ) truncated = true;
+					if ( !fraction ) exponent++;
+				}
+			}
+		}
+
+		inline bool isFloatHalfway( double d )
+		{
+			// A double lies exactly halfway between two floats if the 29 bits that
+			// are cut off when converting to float are 1000...
+			if ( std::fabs( d ) < FLT_MIN ) return true;
+
+			uint64_t bits;
+			memcpy( &bits, &d, sizeof( bits ) );
+			return ( bits & 0x1FFFFFFF ) == 0x10000000;
+		}
+
+		inline float decimalToFloat( uint64_t mantissa, int exponent, bool truncated, const char* token, size_t length )
+		{
+			static const float floatPowers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+			static const double doublePowers[] = {
+				1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+				1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+			};
+
+			if ( mantissa == 0 ) return 0.0f;
+
+			if ( !truncated ) {
+				// Both operands are exact, so a single operation rounds correctly
+				if ( mantissa <= ( 1 << 24 ) && exponent >= -10 && exponent <= 10 ) {
+					float m = (float)mantissa;
+					return exponent < 0 ? m / floatPowers[-exponent] : m * floatPowers[exponent];
+				}
+
+				if ( mantissa <= ( (uint64_t)1 << 53 ) && exponent >= -22 && exponent <= 22 ) {
+					double m = (double)mantissa;
+					double d = exponent < 0 ? m / doublePowers[-exponent] : m * doublePowers[exponent];
+					if ( !isFloatHalfway( d ) ) return (float)d;
+				}
+			}
+
+			// Out of range numbers fail to extract, but overflow yields the largest float
+			float f = 0.0f;
+			std::istringstream stream( std::string( token, length ) );
+			stream.imbue( std::locale::classic() );
+			if ( !( stream >> f ) && f != 0.0f ) f = std::numeric_limits<float>::infinity();
+			return f;
+		}
+
+		inline int readInt( const char* buf, const char* end, int& out )
+		{
+			const char* p = buf;
+			bool neg = false;
+			if ( p < end && *p == '-' ) { neg = true; p++; }
+
+			const char* digits = p;
+			unsigned int n = 0;
+			for ( ; p < end && (unsigned int)( *p - '0' ) <= 9; p++ )
+				n = n * 10 + ( *p - '0' );
+
+			// Saturate instead of overflowing, which only longer numbers can do
+			if ( p - digits > 9 ) {
+				int64_t wide = 0;
+				for ( ; digits < p && wide <= INT_MAX; digits++ )
+					wide = wide * 10 + ( *digits - '0' );
+				n = (unsigned int)std::min<int64_t>( wide, INT_MAX );
+			}
+
+			out = neg ? -(int)n : (int)n;
+			return p - buf;
+		}
+
+		inline int readFloat( const char* buf, const char* end, float& out )
+		{
+			const char* p = buf;
+			bool neg = false;
+			if ( p < end && ( *p == '-' || *p == '+' ) ) { neg = *p == '-'; p++; }
+			const char* start = p;
+
+			uint64_t mantissa = 0;
+			int significant = 0, exponent = 0;
+			bool truncated = false;
+
+			// Integer and fractional digits, numbers of up to 19 digits are read
+			// in one pass and longer ones again with their excess digits dropped
+			const char* intStart = p;
+			for ( ; p < end && (unsigned int)( *p - '0' ) <= 9; p++ )
+				mantissa = mantissa * 10 + ( *p - '0' );
+			const char* intEnd = p;
+
+			const char* fracStart = p;
+			if ( p < end && *p == '.' ) {
+				fracStart = ++p;
+				for ( ; p < end && (unsigned int)( *p - '0' ) <= 9; p++ )
+					mantissa = mantissa * 10 + ( *p - '0' );
+			}
+			const char* fracEnd = p;
+
+			bool hasDigits = intEnd > intStart || fracEnd > fracStart;
+
+			if ( ( intEnd - intStart ) + ( fracEnd - fracStart ) <= 19 ) {
+				exponent = -(int)( fracEnd - fracStart );
+			} else {
+				mantissa = 0;
+				accumulateDigits( intStart, intEnd, false, mantissa, significant, exponent, truncated );
+				accumulateDigits( fracStart, fracEnd, true, mantissa, significant, exponent, truncated );
+			}
+
+			if ( !hasDigits ) {
+				out = 0.0f;
+				return 0;
+			}
+
+			// Exponent
+			if ( p < end && ( *p == 'e' || *p == 'E' ) ) {
+				const char* e = p + 1;
+				bool expNeg = false;
+				if ( e < end && ( *e == '-' || *e == '+' ) ) { expNeg = *e == '-'; e++; }
+
+				const char* digits = e;
+				int n = 0;
+				for ( ; e < end && (unsigned int)( *e - '0' ) <= 9; e++ )
+					if ( n < 100000 ) n = n * 10 + ( *e - '0' );
+
+				if ( e > digits ) {
+					exponent += expNeg ? -n : n;
+					p = e;
+				}
+			}
+
+			float f = decimalToFloat( mantissa, exponent, truncated, start, p - start );
+			out = neg ? -f : f;
+
+			return p - buf;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#pragma once
+
+#ifndef OOGL_STATICBATCH_HPP
+#define OOGL_STATICBATCH_HPP
+
+#include <GL/Platform.hpp>
+#include <GL/Util/Mesh.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <vector>
+
+namespace GL
+{
+	/*
+		Static geometry merged into a single mesh
+
+		Every added mesh is transformed on the CPU and appended to one indexed
+		mesh, so the whole batch needs a single vertex buffer, element buffer
+		and vertex array. The triangles are sorted by material and all
+		instances with the same material end up in one submesh, which makes the
+		submeshes of the result the draw ranges: one DrawElements call each.
+
+		Materials of different meshes are merged when their properties and
+		texture files are equal, meshes without materials share the default one.
+	*/
+	class StaticBatch
+	{
+	public:
+		// The mesh is referenced, not copied, and has to stay alive until Build.
+		// Returns the number of the instance.
+		uint Add( const Mesh& mesh, const Mat4& transform );
+		uint InstanceCount() const;
+		void Clear();
+
+		// Positions are transformed as points and normals with the inverse
+		// transpose of the transform, mirroring transforms flip the winding.
+		// Tangents are kept if all meshes have them and computed for the whole
+		// batch if only some do.
+		Mesh Build() const;
+
+	private:
+		struct instance
+		{
+			const Mesh* mesh;
+			Mat4 transform;
+		};
+
+		std::vector<instance> instances;
+	};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include <GL/OOGL.hpp>
+#include <GL/Util/AssetLoader.hpp>
+#include <iostream>
+#include <cstring>
+
+// Loads the sample assets through AssetLoader from several threads at once
+// and checks every result against a load on the main thread
+
+const char* meshFiles[] = { "tank.obj", "platform.obj", "scene.obj" };
+const char* imageFiles[] = { "tank.jpg", "platform.png", "scene.png" };
+
+const GL::MeshOptions::mesh_options_t meshOptions[] = {
+	GL::MeshOptions::Base,
+	GL::MeshOptions::Indexed | GL::MeshOptions::Optimize,
+	GL::MeshOptions::Indexed | GL::MeshOptions::Clusters | GL::MeshOptions::Tangents | GL::MeshOptions::Cache
+};
+
+const int queueThreads = 4;
+const int rounds = 8;
+
+bool sameMesh( const GL::Mesh& a, const GL::Mesh& b )
+{
+	if ( a.VertexCount() != b.VertexCount() || a.IndexCount() != b.IndexCount() || a.ClusterCount() != b.ClusterCount() ) return false;
+	if ( a.HasTangents() != b.HasTangents() ) return false;
+
+	if ( memcmp( a.Vertices(), b.Vertices(), a.VertexCount() * sizeof( GL::Vertex ) ) != 0 ) return false;
+	if ( a.IndexCount() > 0 && memcmp( a.Indices(), b.Indices(), a.IndexCount() * sizeof( GL::uint ) ) != 0 ) return false;
+	if ( a.HasTangents() && memcmp( a.Tangents(), b.Tangents(), a.VertexCount() * sizeof( GL::Vec4 ) ) != 0 ) return false;
+
+	return true;
+}
+
+bool sameImage( const GL::Image& a, const GL::Image& b )
+{
+	if ( a.GetWidth() != b.GetWidth() || a.GetHeight() != b.GetHeight() ) return false;
+	return memcmp( a.GetPixels(), b.GetPixels(), a.GetWidth() * a.GetHeight() * sizeof( GL::Color ) ) == 0;
+}
+
+int main()
+{
+	const int meshCount = sizeof( meshFiles ) / sizeof( meshFiles[0] );
+	const int optionCount = sizeof( meshOptions ) / sizeof( meshOptions[0] );
+	const int imageCount = sizeof( imageFiles ) / sizeof( imageFiles[0] );
+
+	// Reference results, loaded one at a time without the cache
+	std::vector<std::shared_ptr<GL::Mesh>> referenceMeshes;
+	for ( int m = 0; m < meshCount; m++ )
+		for ( int o = 0; o < optionCount; o++ )
+			referenceMeshes.push_back( std::make_shared<GL::Mesh>( meshFiles[m], (GL::MeshOptions::mesh_options_t)( meshOptions[o] & ~GL::MeshOptions::Cache ) ) );
+
+	std::vector<std::shared_ptr<GL::Image>> referenceImages;
+	for ( int i = 0; i < imageCount; i++ )
+		referenceImages.push_back( std::make_shared<GL::Image>( imageFiles[i] ) );
+
+	// Every thread queues all assets a number of times, so the same files
+	// are parsed and cached by several workers at once
+	GL::AssetLoader loader;
+	std::mutex futuresMutex;
+	std::vector<std::pair<int, std::shared_future<std::shared_ptr<const GL::Mesh>>>> meshes;
+	std::vector<std::pair<int, std::shared_future<std::shared_ptr<const GL::Image>>>> images;
+
+	std::vector<std::thread> threads;
+	for ( int t = 0; t < queueThreads; t++ )
+	{
+		threads.push_back( std::thread( [&]() {
+			for ( int r = 0; r < rounds; r++ )
+			{
+				for ( int m = 0; m < meshCount; m++ )
+				{
+					for ( int o = 0; o < optionCount; o++ )
+					{
+						std::shared_future<std::shared_ptr<const GL::Mesh>> future = loader.QueueMesh( meshFiles[m], meshOptions[o] );
+						std::lock_guard<std::mutex> lock( futuresMutex );
+						meshes.push_back( std::make_pair( m * optionCount + o, future ) );
+					}
+				}
+
+				for ( int i = 0; i < imageCount; i++ )
+				{
+					std::shared_future<std::shared_ptr<const GL::Image>> future = loader.QueueImage( imageFiles[i] );
+					std::lock_guard<std::mutex> lock( futuresMutex );
+					images.push_back( std::make_pair( i, future ) );
+				}
+			}
+		} ) );
+	}
+
+	for ( size_t t = 0; t < threads.size(); t++ )
+		threads[t].join();
+
+	// Failed loads must rethrow their exception from the future
+	std::shared_future<std::shared_ptr<const GL::Mesh>> missing = loader.QueueMesh( "missing.obj" );
+
+	int failures = 0;
+
+	for ( size_t i = 0; i < meshes.size(); i++ )
+	{
+		try {
+			if ( !sameMesh( *meshes[i].second.get(), *referenceMeshes[meshes[i].first] ) ) {
+				std::cout << "Mismatch in " << meshFiles[meshes[i].first / optionCount] << " with options " << meshOptions[meshes[i].first % optionCount] << std::endl;
+				failures++;
+			}
+		} catch ( std::exception& e ) {
+			std::cout << "Loading " << meshFiles[meshes[i].first / optionCount] << " failed: " << e.what() << std::endl;
+			failures++;
+		}
+	}
+
+	for ( size_t i = 0; i < images.size(); i++ )
+	{
+		try {
+			if ( !sameImage( *images[i].second.get(), *referenceImages[images[i].first] ) ) {
+				std::cout << "Mismatch in " << imageFiles[images[i].first] << std::endl;
+				failures++;
+			}
+		} catch ( std::exception& e ) {
+			std::cout << "Loading " << imageFiles[images[i].first] << " failed: " << e.what() << std::endl;
+			failures++;
+		}
+	}
+
+	try {
+		missing.get();
+		std::cout << "Loading missing.obj did not fail" << std::endl;
+		failures++;
+	} catch ( GL::FileException& ) {}
+
+	std::cout << meshes.size() << " meshes and " << images.size() << " images loaded, " << failures << " failures" << std::endl;
+
+	return failures == 0 ? 0 : 1;
+}
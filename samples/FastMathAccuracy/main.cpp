@@ -0,0 +1,120 @@
+#include <GL/Math/Util.hpp>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <cstring>
+#include <cmath>
+
+// Measures the error of the functions in GL::Fast against the double
+// precision standard functions and checks it against the documented bounds
+
+const int samples = 20000000;
+
+// Distance from v to the next float away from zero
+double ulp( double v )
+{
+	float f = (float)fabs( v );
+	return (double)nextafterf( f, std::numeric_limits<float>::infinity() ) - f;
+}
+
+bool check( const char* name, double error, double bound, const char* unit )
+{
+	bool passed = error <= bound;
+	std::cout << std::left << std::setw( 32 ) << name << std::right << std::setw( 12 ) << std::setprecision( 3 ) << error
+		<< " " << std::left << std::setw( 6 ) << unit << "(bound " << bound << ")" << ( passed ? "" : "  FAILED" ) << std::endl;
+	return passed;
+}
+
+bool checkSinCos( float range, double absBound, double ulpBound )
+{
+	double sinAbs = 0.0, cosAbs = 0.0, sinUlp = 0.0, cosUlp = 0.0;
+
+	for ( int i = 0; i <= samples; i++ )
+	{
+		float ang = (float)( -range + 2.0 * range * i / samples );
+		float s, c;
+		GL::Fast::SinCos( ang, s, c );
+
+		double es = sin( (double)ang ), ec = cos( (double)ang );
+		sinAbs = std::max( sinAbs, fabs( s - es ) );
+		cosAbs = std::max( cosAbs, fabs( c - ec ) );
+		sinUlp = std::max( sinUlp, fabs( s - es ) / ulp( es ) );
+		cosUlp = std::max( cosUlp, fabs( c - ec ) / ulp( ec ) );
+	}
+
+	std::cout << std::endl << "SinCos for |ang| <= " << range << std::endl;
+	bool passed = check( "Sine", sinAbs, absBound, "" );
+	passed = check( "Cosine", cosAbs, absBound, "" ) && passed;
+	if ( ulpBound > 0.0 ) {
+		passed = check( "Sine", sinUlp, ulpBound, "ulp" ) && passed;
+		passed = check( "Cosine", cosUlp, ulpBound, "ulp" ) && passed;
+	}
+
+	return passed;
+}
+
+bool checkTan()
+{
+	double worst = 0.0;
+
+	for ( int i = 0; i <= samples; i++ )
+	{
+		float ang = (float)( -GL::PI + 2.0 * GL::PI * i / samples );
+		double exact = tan( (double)ang );
+		worst = std::max( worst, fabs( GL::Fast::Tan( ang ) - exact ) / ulp( exact ) );
+	}
+
+	std::cout << std::endl << "Tan for |ang| <= PI" << std::endl;
+	return check( "Tangent", worst, 4.0, "ulp" );
+}
+
+bool checkRSqrt()
+{
+	double worst = 0.0;
+
+	// Every 37th positive normal float
+	for ( unsigned int bits = 0x00800000; bits < 0x7f800000; bits += 37 )
+	{
+		float x;
+		memcpy( &x, &bits, sizeof( x ) );
+		worst = std::max( worst, fabs( GL::Fast::RSqrt( x ) * sqrt( (double)x ) - 1.0 ) );
+	}
+
+	std::cout << std::endl << "RSqrt for positive normal floats" << std::endl;
+	return check( "Relative error", worst, 3e-7, "" );
+}
+
+// Angles outside the reduction range go to the standard functions
+bool checkOutOfRange()
+{
+	const float inf = std::numeric_limits<float>::infinity();
+	const float angles[] = { std::numeric_limits<float>::quiet_NaN(), inf, -inf, 8192.5f, -3e9f, 1e10f, 3e38f };
+
+	bool passed = true;
+	for ( size_t i = 0; i < sizeof( angles ) / sizeof( angles[0] ); i++ )
+	{
+		float s, c;
+		GL::Fast::SinCos( angles[i], s, c );
+
+		float es = sinf( angles[i] ), ec = cosf( angles[i] );
+		bool same = ( s == es || ( s != s && es != es ) ) && ( c == ec || ( c != c && ec != ec ) );
+		if ( !same ) std::cout << "SinCos( " << angles[i] << " ) differs from sin and cos" << std::endl;
+		passed = passed && same;
+	}
+
+	std::cout << std::endl << "Out of range angles " << ( passed ? "match the standard functions" : "FAILED" ) << std::endl;
+	return passed;
+}
+
+int main()
+{
+	std::cout << std::scientific;
+
+	bool passed = checkSinCos( GL::PI, 8e-8, 1.5 );
+	passed = checkSinCos( 8192.0f, 8e-8, 0.0 ) && passed;
+	passed = checkTan() && passed;
+	passed = checkRSqrt() && passed;
+	passed = checkOutOfRange() && passed;
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,341 @@
+#include <GL/Math/Vec3Array.hpp>
+#include <GL/Math/Mat4.hpp>
+#include <GL/Math/Transform.hpp>
+#include <GL/Math/AABB.hpp>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+
+// Times the vectorized, batch, specialized and inlined math paths against
+// the ones they replace, every measurement is the fastest of a number of rounds
+
+const int rounds = 20;
+
+volatile float sink;
+
+float randomFloat()
+{
+	return rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+template <typename F>
+double best( F f )
+{
+	typedef std::chrono::steady_clock clock;
+
+	double fastest = 1e9;
+	for ( int r = 0; r < rounds; r++ )
+	{
+		clock::time_point start = clock::now();
+		f();
+		double ms = std::chrono::duration<double, std::milli>( clock::now() - start ).count();
+		if ( ms < fastest ) fastest = ms;
+	}
+
+	return fastest;
+}
+
+// Runs f repeatedly per round, for work that is too short to time once
+const int repeats = 256;
+
+template <typename F>
+double bestRepeated( F f )
+{
+	return best( [&]() { for ( int r = 0; r < repeats; r++ ) f(); } );
+}
+
+void heading( const std::string& title, const std::string& baseline, const std::string& fast )
+{
+	std::cout << std::endl << std::left << std::setw( 24 ) << title << std::right
+		<< std::setw( 13 ) << baseline << std::setw( 13 ) << fast << std::setw( 9 ) << "Speedup" << std::endl;
+}
+
+void report( const char* name, double baseline, double fast )
+{
+	std::cout << std::left << std::setw( 24 ) << name << std::right << std::fixed << std::setprecision( 3 )
+		<< std::setw( 10 ) << baseline << " ms" << std::setw( 10 ) << fast << " ms"
+		<< std::setw( 8 ) << std::setprecision( 2 ) << baseline / fast << "x" << std::endl;
+}
+
+// Mat4 products as they were written before they were vectorized, with
+// Translate and the rotations building a matrix and multiplying by it
+namespace scalar
+{
+	GL::Mat4 multiply( const GL::Mat4& a, const GL::Mat4& b )
+	{
+		const float* m = a.m;
+		const float* o = b.m;
+		return GL::Mat4(
+			m[0]*o[0]+m[4]*o[1]+m[8]*o[2]+m[12]*o[3], m[0]*o[4]+m[4]*o[5]+m[8]*o[6]+m[12]*o[7], m[0]*o[8]+m[4]*o[9]+m[8]*o[10]+m[12]*o[11], m[0]*o[12]+m[4]*o[13]+m[8]*o[14]+m[12]*o[15],
+			m[1]*o[0]+m[5]*o[1]+m[9]*o[2]+m[13]*o[3], m[1]*o[4]+m[5]*o[5]+m[9]*o[6]+m[13]*o[7], m[1]*o[8]+m[5]*o[9]+m[9]*o[10]+m[13]*o[11], m[1]*o[12]+m[5]*o[13]+m[9]*o[14]+m[13]*o[15],
+			m[2]*o[0]+m[6]*o[1]+m[10]*o[2]+m[14]*o[3], m[2]*o[4]+m[6]*o[5]+m[10]*o[6]+m[14]*o[7], m[2]*o[8]+m[6]*o[9]+m[10]*o[10]+m[14]*o[11], m[2]*o[12]+m[6]*o[13]+m[10]*o[14]+m[14]*o[15],
+			m[3]*o[0]+m[7]*o[1]+m[11]*o[2]+m[15]*o[3], m[3]*o[4]+m[7]*o[5]+m[11]*o[6]+m[15]*o[7], m[3]*o[8]+m[7]*o[9]+m[11]*o[10]+m[15]*o[11], m[3]*o[12]+m[7]*o[13]+m[11]*o[14]+m[15]*o[15]
+		);
+	}
+
+	GL::Vec4 multiply( const GL::Mat4& a, const GL::Vec4& v )
+	{
+		const float* m = a.m;
+		return GL::Vec4(
+			m[0]*v.X + m[4]*v.Y + m[8]*v.Z + m[12]*v.W,
+			m[1]*v.X + m[5]*v.Y + m[9]*v.Z + m[13]*v.W,
+			m[2]*v.X + m[6]*v.Y + m[10]*v.Z + m[14]*v.W,
+			m[3]*v.X + m[7]*v.Y + m[11]*v.Z + m[15]*v.W
+		);
+	}
+
+	GL::Mat4 translate( const GL::Mat4& m, const GL::Vec3& v )
+	{
+		return multiply( m, GL::Mat4(
+			1, 0, 0, v.X,
+			0, 1, 0, v.Y,
+			0, 0, 1, v.Z,
+			0, 0, 0, 1
+		) );
+	}
+
+	GL::Mat4 scale( const GL::Mat4& m, const GL::Vec3& v )
+	{
+		return multiply( m, GL::Mat4(
+			v.X, 0, 0, 0,
+			0, v.Y, 0, 0,
+			0, 0, v.Z, 0,
+			0, 0, 0, 1
+		) );
+	}
+
+	GL::Mat4 rotateX( const GL::Mat4& m, float ang )
+	{
+		return multiply( m, GL::Mat4(
+			1, 0, 0, 0,
+			0, cos( ang ), -sin( ang ), 0,
+			0, sin( ang ), cos( ang ), 0,
+			0, 0, 0, 1
+		) );
+	}
+
+	GL::Mat4 rotate( const GL::Mat4& m, const GL::Vec3& axis, float ang )
+	{
+		float s = sin( ang );
+		float c = cos( ang );
+		float t = 1 - c;
+		GL::Vec3 a = axis.Normal();
+
+		return multiply( m, GL::Mat4(
+			a.X * a.X * t + c, a.X * a.Y * t - a.Z * s, a.X * a.Z * t + a.Y * s, 0,
+			a.Y * a.X * t + a.Z * s, a.Y * a.Y * t + c, a.Y * a.Z * t - a.X * s, 0,
+			a.Z * a.X * t - a.Y * s, a.Z * a.Y * t + a.X * s, a.Z * a.Z * t + c, 0,
+			0, 0, 0, 1
+		) );
+	}
+}
+
+// The math functions as calls that are not inlined, like they were when
+// they were compiled in the library instead of defined in the headers
+namespace outOfLine
+{
+	OOGL_NOINLINE GL::Mat4& translate( GL::Mat4& m, const GL::Vec3& v ) { return m.Translate( v ); }
+	OOGL_NOINLINE GL::Mat4& rotateY( GL::Mat4& m, float ang ) { return m.RotateY( ang ); }
+	OOGL_NOINLINE GL::Mat4& scale( GL::Mat4& m, const GL::Vec3& v ) { return m.Scale( v ); }
+	OOGL_NOINLINE GL::Mat4 multiply( const GL::Mat4& a, const GL::Mat4& b ) { return a * b; }
+	OOGL_NOINLINE GL::AABB transform( const GL::AABB& box, const GL::Mat4& m ) { return box.Transform( m ); }
+	OOGL_NOINLINE void extend( GL::AABB& box, const GL::AABB& other ) { box.Extend( other ); }
+}
+
+void benchmarkProducts()
+{
+	// The matrices fit in the cache, so the arithmetic is measured instead of
+	// the memory bandwidth, and every pass over them is repeated
+	const size_t count = 1 << 12;
+
+	std::vector<GL::Mat4> mats( count ), others( count ), out( count );
+	std::vector<GL::Vec4> vectors( count ), vectorsOut( count );
+	std::vector<GL::Vec3> axes( count );
+	std::vector<float> angles( count );
+	for ( size_t i = 0; i < count; i++ )
+	{
+		for ( int k = 0; k < 16; k++ )
+		{
+			mats[i].m[k] = randomFloat();
+			others[i].m[k] = randomFloat();
+		}
+		vectors[i] = GL::Vec4( randomFloat(), randomFloat(), randomFloat(), 1.0f );
+		axes[i] = GL::Vec3( randomFloat(), randomFloat(), randomFloat() + 2.0f );
+		angles[i] = randomFloat() * 3.0f;
+	}
+
+	heading( "Mat4 products", "Scalar", "Mat4" );
+	std::cout << count * repeats << " products each" << std::endl;
+
+	report( "Mat4 * Mat4",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = scalar::multiply( mats[i], others[i] ); sink = out[count / 2].m[3]; } ),
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = mats[i] * others[i]; sink = out[count / 2].m[3]; } ) );
+	report( "Mat4 * Vec4",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) vectorsOut[i] = scalar::multiply( mats[i], vectors[i] ); sink = vectorsOut[count / 2].X; } ),
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) vectorsOut[i] = mats[i] * vectors[i]; sink = vectorsOut[count / 2].X; } ) );
+	report( "Mat4::Transform",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) vectorsOut[i] = scalar::multiply( mats[0], vectors[i] ); sink = vectorsOut[count / 2].X; } ),
+		bestRepeated( [&]() { mats[0].Transform( &vectors[0], &vectorsOut[0], count ); sink = vectorsOut[count / 2].X; } ) );
+	report( "Translate",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = scalar::translate( mats[i], axes[i] ); sink = out[count / 2].m[3]; } ),
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = GL::Mat4( mats[i] ).Translate( axes[i] ); sink = out[count / 2].m[3]; } ) );
+	report( "Scale",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = scalar::scale( mats[i], axes[i] ); sink = out[count / 2].m[3]; } ),
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = GL::Mat4( mats[i] ).Scale( axes[i] ); sink = out[count / 2].m[3]; } ) );
+	report( "RotateX",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = scalar::rotateX( mats[i], angles[i] ); sink = out[count / 2].m[3]; } ),
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = GL::Mat4( mats[i] ).RotateX( angles[i] ); sink = out[count / 2].m[3]; } ) );
+	report( "Rotate",
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = scalar::rotate( mats[i], axes[i], angles[i] ); sink = out[count / 2].m[3]; } ),
+		bestRepeated( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = GL::Mat4( mats[i] ).Rotate( axes[i], angles[i] ); sink = out[count / 2].m[3]; } ) );
+}
+
+void benchmarkVec3Array()
+{
+	const size_t count = 1 << 20;
+
+	std::vector<GL::Vec3> points( count ), others( count ), out( count );
+	std::vector<float> scalars( count );
+	for ( size_t i = 0; i < count; i++ )
+	{
+		points[i] = GL::Vec3( randomFloat(), randomFloat(), randomFloat() );
+		others[i] = GL::Vec3( randomFloat(), randomFloat(), randomFloat() );
+	}
+
+	GL::Mat4 m;
+	m.Translate( GL::Vec3( 1, 2, 3 ) ).RotateY( 0.3f ).Scale( GL::Vec3( 2, 2, 2 ) );
+
+	GL::Vec3Array p( &points[0], count ), q( &others[0], count ), o( count );
+
+	heading( "Vec3Array", "Per object", "Batch" );
+
+	report( "Transform points",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = m * points[i]; sink = out[count / 2].X; } ),
+		best( [&]() { p.TransformPoints( m, o ); sink = o.X()[count / 2]; } ) );
+	report( "Mat4::TransformPoints",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = m * points[i]; sink = out[count / 2].X; } ),
+		best( [&]() { m.TransformPoints( &points[0], &out[0], count ); sink = out[count / 2].X; } ) );
+	report( "Normal",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = points[i].Normal(); sink = out[count / 2].X; } ),
+		best( [&]() { p.Normal( o ); sink = o.X()[count / 2]; } ) );
+	report( "Cross",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = points[i].Cross( others[i] ); sink = out[count / 2].X; } ),
+		best( [&]() { p.Cross( q, o ); sink = o.X()[count / 2]; } ) );
+	report( "Dot",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) scalars[i] = points[i].Dot( others[i] ); sink = scalars[count / 2]; } ),
+		best( [&]() { p.Dot( q, &scalars[0] ); sink = scalars[count / 2]; } ) );
+	report( "Length",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) scalars[i] = points[i].Length(); sink = scalars[count / 2]; } ),
+		best( [&]() { p.Length( &scalars[0] ); sink = scalars[count / 2]; } ) );
+
+	// Converting costs about as much as one pass, so it pays off from two kernels on
+	std::cout << "Converting to and from Vec3Array: " << std::setprecision( 3 )
+		<< best( [&]() { p.Assign( &points[0], count ); sink = p.X()[count / 2]; } ) << " ms, "
+		<< best( [&]() { p.CopyTo( &out[0] ); sink = out[count / 2].X; } ) << " ms" << std::endl;
+}
+
+void benchmarkInverses()
+{
+	const size_t count = 1000000;
+
+	// View matrices are rigid, view-projection matrices need the general inverse
+	std::vector<GL::Mat4> views( count ), viewProjections( count ), out( count );
+	std::vector<GL::Mat3> normals( count );
+	std::vector<GL::Transform> transforms( count );
+	for ( size_t i = 0; i < count; i++ )
+	{
+		views[i] = GL::Mat4::LookAt( GL::Vec3( randomFloat(), randomFloat(), randomFloat() ) * 10.0f, GL::Vec3( randomFloat(), randomFloat(), randomFloat() ), GL::Vec3( 0, 1, 0 ) );
+		viewProjections[i] = GL::Mat4::Perspective( 1.0f + randomFloat() * 0.2f, 1.5f, 0.1f, 100.0f ) * views[i];
+	}
+
+	double general = best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = viewProjections[i].Inverse(); sink = out[count / 2].m[3]; } );
+
+	heading( "Mat4 inverses", "General", "Specialized" );
+
+	report( "Inverse of affine",
+		general,
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = views[i].Inverse(); sink = out[count / 2].m[3]; } ) );
+	report( "AffineInverse",
+		general,
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = views[i].AffineInverse(); sink = out[count / 2].m[3]; } ) );
+	report( "RigidInverse",
+		general,
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = views[i].RigidInverse(); sink = out[count / 2].m[3]; } ) );
+	report( "NormalMatrix",
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = viewProjections[i].Inverse().Transpose(); sink = out[count / 2].m[3]; } ),
+		best( [&]() { for ( size_t i = 0; i < count; i++ ) normals[i] = views[i].NormalMatrix(); sink = normals[count / 2].m[3]; } ) );
+
+	std::cout << "Decomposing and recomposing: " << std::setprecision( 3 )
+		<< best( [&]() { for ( size_t i = 0; i < count; i++ ) transforms[i] = GL::Transform( views[i] ); sink = transforms[count / 2].Scale.X; } ) << " ms, "
+		<< best( [&]() { for ( size_t i = 0; i < count; i++ ) out[i] = transforms[i].ToMat4(); sink = out[count / 2].m[3]; } ) << " ms" << std::endl;
+}
+
+void benchmarkTransformUpdate()
+{
+	// Every frame the objects get a new local matrix, which is combined with
+	// the world matrix of their parent and used to move their bounds into the
+	// bounds of the scene
+	const size_t count = 100000;
+
+	std::vector<GL::Vec3> positions( count ), scales( count );
+	std::vector<float> angles( count );
+	std::vector<size_t> parents( count );
+	std::vector<GL::Mat4> worlds( count ), inlineWorlds( count );
+	for ( size_t i = 0; i < count; i++ )
+	{
+		positions[i] = GL::Vec3( randomFloat(), randomFloat(), randomFloat() ) * 10.0f;
+		scales[i] = GL::Vec3( 1.0f, 1.0f, 1.0f ) + GL::Vec3( randomFloat(), randomFloat(), randomFloat() ) * 0.5f;
+		angles[i] = randomFloat() * 3.0f;
+		parents[i] = i == 0 ? 0 : ( i - 1 ) / 4;
+	}
+
+	const GL::AABB box( GL::Vec3( -1, -1, -1 ), GL::Vec3( 1, 1, 1 ) );
+	GL::AABB scene, inlineScene;
+
+	heading( "Transform update", "Out of line", "Inline" );
+	std::cout << count << " objects" << std::endl;
+
+	report( "Frame",
+		best( [&]() {
+			scene = GL::AABB();
+			for ( size_t i = 0; i < count; i++ )
+			{
+				GL::Mat4 local;
+				outOfLine::scale( outOfLine::rotateY( outOfLine::translate( local, positions[i] ), angles[i] ), scales[i] );
+				worlds[i] = i == 0 ? local : outOfLine::multiply( worlds[parents[i]], local );
+				outOfLine::extend( scene, outOfLine::transform( box, worlds[i] ) );
+			}
+			sink = scene.Max.X;
+		} ),
+		best( [&]() {
+			inlineScene = GL::AABB();
+			for ( size_t i = 0; i < count; i++ )
+			{
+				GL::Mat4 local;
+				local.Translate( positions[i] ).RotateY( angles[i] ).Scale( scales[i] );
+				inlineWorlds[i] = i == 0 ? local : inlineWorlds[parents[i]] * local;
+				inlineScene.Extend( box.Transform( inlineWorlds[i] ) );
+			}
+			sink = inlineScene.Max.X;
+		} ) );
+
+	bool same = memcmp( &worlds[0], &inlineWorlds[0], count * sizeof( GL::Mat4 ) ) == 0 && memcmp( &scene, &inlineScene, sizeof( scene ) ) == 0;
+	std::cout << "Results " << ( same ? "are identical" : "DIFFER" ) << std::endl;
+}
+
+int main()
+{
+	srand( 1 );
+
+	benchmarkProducts();
+	benchmarkVec3Array();
+	benchmarkInverses();
+	benchmarkTransformUpdate();
+
+	return 0;
+}
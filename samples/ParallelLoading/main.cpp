@@ -0,0 +1,114 @@
+#include <GL/Util/Mesh.hpp>
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+
+// Loads a large generated OBJ file serially and with MeshOptions::Parallel
+// on an increasing amount of threads, and checks that all loads match
+
+const char* filename = "parallel_loading.obj";
+const int rings = 1000, segments = 1200;
+const int rounds = 3;
+
+// A sphere with positions, texture coordinates and normals on every corner
+bool writeSphere()
+{
+	FILE* file = fopen( filename, "w" );
+	if ( !file ) return false;
+
+	for ( int r = 0; r <= rings; r++ )
+	{
+		for ( int s = 0; s <= segments; s++ )
+		{
+			float theta = 3.14159265f * r / rings, phi = 6.2831853f * s / segments;
+			float x = sinf( theta ) * cosf( phi ), y = cosf( theta ), z = sinf( theta ) * sinf( phi );
+			fprintf( file, "v %f %f %f\nvt %f %f\nvn %f %f %f\n", x, y, z, (float)s / segments, (float)r / rings, x, y, z );
+		}
+	}
+
+	for ( int r = 0; r < rings; r++ )
+	{
+		for ( int s = 0; s < segments; s++ )
+		{
+			int a = r * ( segments + 1 ) + s + 1, b = a + segments + 1;
+			fprintf( file, "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b, b, b + 1, b + 1, b + 1, a + 1, a + 1, a + 1 );
+		}
+	}
+
+	return fclose( file ) == 0;
+}
+
+bool sameMesh( const GL::Mesh& a, const GL::Mesh& b )
+{
+	if ( a.VertexCount() != b.VertexCount() || a.IndexCount() != b.IndexCount() ) return false;
+	if ( memcmp( a.Vertices(), b.Vertices(), a.VertexCount() * sizeof( GL::Vertex ) ) != 0 ) return false;
+	return a.IndexCount() == 0 || memcmp( a.Indices(), b.Indices(), a.IndexCount() * sizeof( GL::uint ) ) == 0;
+}
+
+// Fastest of a few loads, the mesh of the last one is kept to compare
+double timeLoad( GL::MeshOptions::mesh_options_t options, GL::uint threads, std::unique_ptr<GL::Mesh>& mesh )
+{
+	double fastest = 0.0;
+
+	for ( int i = 0; i < rounds; i++ )
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		mesh.reset();
+		mesh.reset( new GL::Mesh( filename, options, 1.0471976f, threads ) );
+		double time = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+		if ( i == 0 || time < fastest ) fastest = time;
+	}
+
+	return fastest;
+}
+
+int main()
+{
+	std::cout << "Writing " << filename << "..." << std::endl;
+	if ( !writeSphere() ) {
+		std::cout << "Failed to write " << filename << std::endl;
+		return 1;
+	}
+
+	const GL::MeshOptions::mesh_options_t options[] = { GL::MeshOptions::Base, GL::MeshOptions::Indexed };
+	const char* optionNames[] = { "Base", "Indexed" };
+
+	GL::uint cores = std::thread::hardware_concurrency();
+	GL::uint threadCounts[] = { 1, 2, 4, cores };
+	int failures = 0;
+
+	std::cout << std::fixed << std::setprecision( 1 );
+
+	for ( int o = 0; o < 2; o++ )
+	{
+		std::unique_ptr<GL::Mesh> serial, parallel;
+		double serialTime = timeLoad( options[o], 0, serial );
+
+		std::cout << std::endl << optionNames[o] << std::endl;
+		std::cout << std::left << std::setw( 20 ) << "Serial" << std::right << std::setw( 10 ) << serialTime << " ms" << std::endl;
+
+		for ( int t = 0; t < 4; t++ )
+		{
+			// The core count may equal one of the fixed counts
+			if ( t == 3 && ( cores == 1 || cores == 2 || cores == 4 ) ) continue;
+
+			double time = timeLoad( options[o] | GL::MeshOptions::Parallel, threadCounts[t], parallel );
+			bool same = sameMesh( *serial, *parallel );
+			if ( !same ) failures++;
+
+			std::string name = "Parallel, " + std::to_string( threadCounts[t] ) + ( threadCounts[t] == 1 ? " thread" : " threads" );
+			std::cout << std::left << std::setw( 20 ) << name << std::right << std::setw( 10 ) << time << " ms"
+				<< std::setw( 8 ) << serialTime / time << "x" << ( same ? "" : "  MISMATCH" ) << std::endl;
+		}
+	}
+
+	remove( filename );
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+#include <GL/Util/NumberScanner.hpp>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstring>
+
+// Times the number scanner of the OBJ parser against the readInt and
+// readFloat it replaced, on the attribute and face lines of the sample files
+
+const char* files[] = { "tank.obj", "platform.obj", "scene.obj" };
+const int rounds = 100;
+
+volatile float sink;
+
+// The scalar functions as they were before the number scanner
+namespace scalar
+{
+	inline int readInt( const char* buf, const char* end, int& out )
+	{
+		// Read sign and digits
+		const char* p = buf;
+		bool neg = false;
+		if ( p < end && *p == '-' ) { neg = true; p++; }
+
+		int n = 0;
+		while ( p < end && *p >= '0' && *p <= '9' )
+			n = n * 10 + ( *p++ - '0' );
+
+		out = neg ? -n : n;
+		return p - buf;
+	}
+
+	inline int readFloat( const char* buf, const char* end, float& out )
+	{
+		// Read natural part
+		bool neg = buf < end && buf[0] == '-';
+		int nat, frac = 0;
+		int ln = readInt( buf, end, nat );
+
+		// Read fractional part
+		int lf = 0;
+		if ( buf + ln < end && buf[ln] == '.' )
+			lf = readInt( buf + ln + 1, end, frac ) + 1;
+		int p = 1;
+		for ( int i = 1; i < lf; i++ ) p *= 10;
+
+		// Handle sign
+		if ( neg )
+			out = nat - frac / (float)p;
+		else
+			out = nat + frac / (float)p;
+
+		return ln + lf;
+	}
+}
+
+struct scalarReader
+{
+	static int ReadInt( const char* buf, const char* end, int& out ) { return scalar::readInt( buf, end, out ); }
+	static int ReadFloat( const char* buf, const char* end, float& out ) { return scalar::readFloat( buf, end, out ); }
+};
+
+struct scannerReader
+{
+	static int ReadInt( const char* buf, const char* end, int& out ) { return GL::Internal::readInt( buf, end, out ); }
+	static int ReadFloat( const char* buf, const char* end, float& out ) { return GL::Internal::readFloat( buf, end, out ); }
+};
+
+inline const char* skipSpacing( const char* p, const char* end )
+{
+	while ( p < end && ( *p == ' ' || *p == '\t' || *p == '\r' ) ) p++;
+	return p;
+}
+
+// Reads the numbers on the v, vt, vn and f lines like the parser does, the
+// floats are appended to floats if it is given
+template <typename Reader>
+float readNumbers( const std::string& text, std::vector<float>* floats )
+{
+	const char* p = text.data();
+	const char* end = p + text.size();
+	float sum = 0.0f;
+
+	while ( p < end )
+	{
+		const char* eol = (const char*)memchr( p, '\n', end - p );
+		if ( !eol ) eol = end;
+
+		if ( p[0] == 'v' ) {
+			p += p + 1 < eol && ( p[1] == 't' || p[1] == 'n' ) ? 2 : 1;
+			for ( p = skipSpacing( p, eol ); p < eol; p = skipSpacing( p, eol ) )
+			{
+				float f;
+				int length = Reader::ReadFloat( p, eol, f );
+				if ( length == 0 ) break;
+				if ( floats ) floats->push_back( f );
+				sum += f;
+				p += length;
+			}
+		} else if ( p[0] == 'f' ) {
+			for ( p = skipSpacing( p + 1, eol ); p < eol; p = skipSpacing( p, eol ) )
+			{
+				int index;
+				int length = Reader::ReadInt( p, eol, index );
+				if ( length == 0 && *p != '/' ) break;
+				sum += index;
+				p += length;
+				if ( p < eol && *p == '/' ) p++;
+			}
+		}
+
+		p = eol + 1;
+	}
+
+	return sum;
+}
+
+template <typename Reader>
+double best( const std::string& text )
+{
+	double fastest = 0.0;
+
+	for ( int i = 0; i < rounds; i++ )
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		sink = readNumbers<Reader>( text, 0 );
+		double time = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+		if ( i == 0 || time < fastest ) fastest = time;
+	}
+
+	return fastest;
+}
+
+int main()
+{
+	std::cout << std::left << std::setw( 16 ) << "File" << std::right << std::setw( 12 ) << "Scalar" << std::setw( 13 ) << "Scanner"
+		<< std::setw( 9 ) << "Speedup" << std::setw( 14 ) << "Differences" << std::endl;
+
+	for ( size_t i = 0; i < sizeof( files ) / sizeof( files[0] ); i++ )
+	{
+		std::ifstream file( files[i], std::ios::binary );
+		if ( !file.is_open() ) {
+			std::cout << "Failed to open " << files[i] << std::endl;
+			return 1;
+		}
+
+		std::stringstream buffer;
+		buffer << file.rdbuf();
+		std::string text = buffer.str();
+
+		double scalarTime = best<scalarReader>( text );
+		double scannerTime = best<scannerReader>( text );
+
+		// The scanner rounds correctly, the scalar code did not always
+		std::vector<float> scalarFloats, scannerFloats;
+		readNumbers<scalarReader>( text, &scalarFloats );
+		readNumbers<scannerReader>( text, &scannerFloats );
+
+		size_t differences = 0;
+		for ( size_t j = 0; j < scalarFloats.size() && j < scannerFloats.size(); j++ )
+			if ( scalarFloats[j] != scannerFloats[j] ) differences++;
+
+		std::cout << std::left << std::setw( 16 ) << files[i] << std::right << std::fixed << std::setprecision( 3 )
+			<< std::setw( 9 ) << scalarTime << " ms" << std::setw( 10 ) << scannerTime << " ms"
+			<< std::setprecision( 2 ) << std::setw( 8 ) << scalarTime / scannerTime << "x"
+			<< std::setw( 7 ) << differences << " of " << scannerFloats.size() << std::endl;
+	}
+
+	return 0;
+}
@@ -7,13 +7,14 @@ int main()
 	GL::Context& gl = window.GetContext( 24, 24, 0, 4 );
 
 	// Setup scene drawing
-	GL::Mesh sceneMesh( "scene.obj" );
+	GL::Mesh sceneMesh( "scene.obj", GL::MeshOptions::Indexed | GL::MeshOptions::Optimize );
 	GL::VertexBuffer sceneBuffer( sceneMesh, GL::BufferUsage::StaticDraw, [] ( const GL::Vertex& v, GL::VertexDataBuffer& data )
 	{
 		data.Vec3( v.Pos );
 		data.Vec3( v.Normal );
 		data.Vec2( v.Tex );
 	} );
+	GL::VertexBuffer sceneIndices( sceneMesh, GL::BufferUsage::StaticDraw );
 
 	GL::Image sceneImage( "scene.png" );
 	GL::Texture sceneTexture( sceneImage );
@@ -36,6 +37,7 @@ int main()
 
 	GL::VertexArray lightVAO;
 	lightVAO.BindAttribute( lightProgram.GetAttribute( "pos" ), sceneBuffer, GL::Type::Float, 3, sizeof(float) * 8, 0 );
+	lightVAO.BindElements( sceneIndices );
 
 	// Setup normal shader
 	GL::Shader normalVert( GL::ShaderType::Vertex, GLSL(
@@ -87,6 +89,7 @@ int main()
 	normalVAO.BindAttribute( normalProgram.GetAttribute( "pos" ), sceneBuffer, GL::Type::Float, 3, sizeof(float) * 8, 0 );
 	normalVAO.BindAttribute( normalProgram.GetAttribute( "normal" ), sceneBuffer, GL::Type::Float, 3, sizeof(float) * 8, sizeof(float) * 3 );
 	normalVAO.BindAttribute( normalProgram.GetAttribute( "texcoord" ), sceneBuffer, GL::Type::Float, 2, sizeof(float) * 8, sizeof(float) * 6 );
+	normalVAO.BindElements( sceneIndices );
 
 	normalProgram.SetUniform( normalProgram.GetUniform( "texCrate" ), 0 );
 	normalProgram.SetUniform( normalProgram.GetUniform( "texLight" ), 1 );
@@ -136,7 +139,7 @@ int main()
 		GL::Mat4 lightTrans = proj * view;
 		lightProgram.SetUniform( lightProgram.GetUniform( "trans" ), lightTrans );
 		
-		gl.DrawArrays( lightVAO, GL::Primitive::Triangles, 0, sceneMesh.VertexCount() );
+		gl.DrawElements( lightVAO, GL::Primitive::Triangles, 0, sceneMesh.IndexCount(), sceneMesh.IndexType() );
 
 		// Draw crate from eye view
 		gl.BindFramebuffer();
@@ -151,7 +154,7 @@ int main()
 		normalProgram.SetUniform( normalProgram.GetUniform("lightTrans"), lightTrans );
 		normalProgram.SetUniform( normalProgram.GetUniform("lightPos"), lightPos );
 		
-		gl.DrawArrays( normalVAO, GL::Primitive::Triangles, 0, sceneMesh.VertexCount() );
+		gl.DrawElements( normalVAO, GL::Primitive::Triangles, 0, sceneMesh.IndexCount(), sceneMesh.IndexType() );
 
 		// Show result
 		window.Present();
@@ -0,0 +1,123 @@
+#include <GL/GL/VertexBuffer.hpp>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+// Times building the data of a VertexBuffer for 10 million vertices in the
+// 32 byte layout of the samples (position, texture coordinates and normal)
+// with the VertexDataBuffer that grew one byte at a time and a std::function
+// per vertex, against the current one. No buffer is created, so this runs
+// without an OpenGL context.
+
+const GL::uint vertexCount = 10000000;
+const int rounds = 3;
+
+volatile GL::uchar sink;
+
+// The builder as it was before VertexDataBuffer wrote with memcpy
+namespace bytewise
+{
+	class VertexDataBuffer
+	{
+	public:
+		void Vec2( const GL::Vec2& v ) { Bytes( (GL::uchar*)&v, sizeof( v ) ); }
+		void Vec3( const GL::Vec3& v ) { Bytes( (GL::uchar*)&v, sizeof( v ) ); }
+
+		void* Pointer() { return &data[0]; }
+		int Size() { return data.size(); }
+
+	private:
+		std::vector<GL::uchar> data;
+
+		void Bytes( GL::uchar* bytes, GL::uint count ) {
+			for ( GL::uint i = 0; i < count; i++ )
+				data.push_back( bytes[i] );
+		}
+	};
+
+	void build( const std::vector<GL::Vertex>& vertices, std::function<void( const GL::Vertex& v, VertexDataBuffer& data )> f )
+	{
+		VertexDataBuffer data;
+		for ( size_t i = 0; i < vertices.size(); i++ )
+			f( vertices[i], data );
+		sink = ( (GL::uchar*)data.Pointer() )[data.Size() - 1];
+	}
+}
+
+// The loop of the VertexBuffer constructor for meshes, with and without
+// reserving room for all vertices up front
+template <typename F>
+void build( const std::vector<GL::Vertex>& vertices, bool reserve, F f )
+{
+	GL::VertexDataBuffer data;
+
+	f( vertices[0], data );
+	if ( reserve ) data.Reserve( data.Size() * vertices.size() );
+
+	for ( size_t i = 1; i < vertices.size(); i++ )
+		f( vertices[i], data );
+	sink = ( (GL::uchar*)data.Pointer() )[data.Size() - 1];
+}
+
+template <typename F>
+double best( F f )
+{
+	double fastest = 0.0;
+
+	for ( int i = 0; i < rounds; i++ )
+	{
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+		f();
+		double time = std::chrono::duration<double, std::milli>( std::chrono::high_resolution_clock::now() - start ).count();
+		if ( i == 0 || time < fastest ) fastest = time;
+	}
+
+	return fastest;
+}
+
+int main()
+{
+	std::vector<GL::Vertex> vertices( vertexCount );
+	for ( size_t i = 0; i < vertices.size(); i++ )
+	{
+		float f = rand() / (float)RAND_MAX;
+		GL::Vertex v = { GL::Vec3( f, 1.0f - f, 0.5f * f ), GL::Vec2( f, f ), GL::Vec3( 0.0f, 1.0f, 0.0f ) };
+		vertices[i] = v;
+	}
+
+	double bytewiseTime = best( [&]() {
+		bytewise::build( vertices, []( const GL::Vertex& v, bytewise::VertexDataBuffer& data ) {
+			data.Vec3( v.Pos );
+			data.Vec2( v.Tex );
+			data.Vec3( v.Normal );
+		} );
+	} );
+
+	double growingTime = best( [&]() {
+		build( vertices, false, []( const GL::Vertex& v, GL::VertexDataBuffer& data ) {
+			data.Vec3( v.Pos );
+			data.Vec2( v.Tex );
+			data.Vec3( v.Normal );
+		} );
+	} );
+
+	double reservedTime = best( [&]() {
+		build( vertices, true, []( const GL::Vertex& v, GL::VertexDataBuffer& data ) {
+			data.Vec3( v.Pos );
+			data.Vec2( v.Tex );
+			data.Vec3( v.Normal );
+		} );
+	} );
+
+	std::cout << vertexCount << " vertices of 32 bytes" << std::endl << std::fixed << std::setprecision( 1 );
+	std::cout << std::left << std::setw( 30 ) << "Byte by byte, std::function" << std::right << std::setw( 10 ) << bytewiseTime << " ms" << std::endl;
+	std::cout << std::left << std::setw( 30 ) << "memcpy, growing" << std::right << std::setw( 10 ) << growingTime << " ms"
+		<< std::setw( 8 ) << std::setprecision( 2 ) << bytewiseTime / growingTime << "x" << std::setprecision( 1 ) << std::endl;
+	std::cout << std::left << std::setw( 30 ) << "memcpy, reserved" << std::right << std::setw( 10 ) << reservedTime << " ms"
+		<< std::setw( 8 ) << std::setprecision( 2 ) << bytewiseTime / reservedTime << "x" << std::endl;
+
+	return 0;
+}
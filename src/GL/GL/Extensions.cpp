@@ -87,6 +87,8 @@ GLBINDBUFFER glBindBuffer;
 GLBUFFERDATA glBufferData;
 GLBUFFERSUBDATA glBufferSubData;
 GLGETBUFFERSUBDATA glGetBufferSubData;
+GLMAPBUFFERRANGE glMapBufferRange;
+GLUNMAPBUFFER glUnmapBuffer;
 
 GLGENVERTEXARRAYS glGenVertexArrays;
 GLDELETEVERTEXARRAYS glDeleteVertexArrays;
@@ -94,6 +96,7 @@ GLBINDVERTEXARRAY glBindVertexArray;
 
 GLENABLEVERTEXATTRIBARRAY glEnableVertexAttribArray;
 GLVERTEXATTRIBPOINTER glVertexAttribPointer;
+GLVERTEXATTRIBIPOINTER glVertexAttribIPointer;
 
 GLGENERATEMIPMAP glGenerateMipmap;
 
@@ -203,6 +206,8 @@ namespace GL
 		glBufferData = (GLBUFFERDATA)LoadExtension( "glBufferData" );
 		glBufferSubData = (GLBUFFERSUBDATA)LoadExtension( "glBufferSubData" );
 		glGetBufferSubData = (GLGETBUFFERSUBDATA)LoadExtension( "glGetBufferSubData" );
+		glMapBufferRange = (GLMAPBUFFERRANGE)LoadExtension( "glMapBufferRange" );
+		glUnmapBuffer = (GLUNMAPBUFFER)LoadExtension( "glUnmapBuffer" );
 
 		glGenVertexArrays = (GLGENVERTEXARRAYS)LoadExtension( "glGenVertexArrays" );
 		glDeleteVertexArrays = (GLDELETEVERTEXARRAYS)LoadExtension( "glDeleteVertexArrays" );
@@ -210,6 +215,7 @@ namespace GL
 
 		glEnableVertexAttribArray = (GLENABLEVERTEXATTRIBARRAY)LoadExtension( "glEnableVertexAttribArray" );
 		glVertexAttribPointer = (GLVERTEXATTRIBPOINTER)LoadExtension( "glVertexAttribPointer" );
+		glVertexAttribIPointer = (GLVERTEXATTRIBIPOINTER)LoadExtension( "glVertexAttribIPointer" );
 
 		glGenerateMipmap = (GLGENERATEMIPMAP)LoadExtension( "glGenerateMipmap" );
 
@@ -49,12 +49,20 @@ namespace GL
 		return *this;
 	}
 
-	void VertexArray::BindAttribute( const Attribute& attribute, const VertexBuffer& buffer, Type::type_t type, uint count, uint stride, intptr_t offset )
+	void VertexArray::BindAttribute( const Attribute& attribute, const VertexBuffer& buffer, Type::type_t type, uint count, uint stride, intptr_t offset, bool normalized )
 	{
 		glBindVertexArray( obj );
 		glBindBuffer( GL_ARRAY_BUFFER, buffer );
 		glEnableVertexAttribArray( attribute );
-		glVertexAttribPointer( attribute, count, type, GL_FALSE, stride, (const GLvoid*)offset );
+		glVertexAttribPointer( attribute, count, type, normalized ? GL_TRUE : GL_FALSE, stride, (const GLvoid*)offset );
+	}
+
+	void VertexArray::BindIntegerAttribute( const Attribute& attribute, const VertexBuffer& buffer, Type::type_t type, uint count, uint stride, intptr_t offset )
+	{
+		glBindVertexArray( obj );
+		glBindBuffer( GL_ARRAY_BUFFER, buffer );
+		glEnableVertexAttribArray( attribute );
+		glVertexAttribIPointer( attribute, count, type, stride, (const GLvoid*)offset );
 	}
 
 	void VertexArray::BindElements( const VertexBuffer& elements )
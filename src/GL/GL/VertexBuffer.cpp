@@ -21,9 +21,228 @@
 
 #include <GL/GL/VertexBuffer.hpp>
 #include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <limits>
 
 namespace GL
 {
+	VertexDataBuffer::VertexDataBuffer()
+	{
+		start = 0;
+		size = capacity = 0;
+		external = false;
+	}
+
+	VertexDataBuffer::VertexDataBuffer( const VertexDataBuffer& other )
+	{
+		start = 0;
+		size = capacity = 0;
+		external = false;
+		*this = other;
+	}
+
+	VertexDataBuffer::VertexDataBuffer( void* memory, size_t capacity )
+	{
+		start = (uchar*)memory;
+		size = 0;
+		this->capacity = capacity;
+		external = true;
+	}
+
+	const VertexDataBuffer& VertexDataBuffer::operator=( const VertexDataBuffer& other )
+	{
+		if ( this == &other ) return *this;
+
+		// Copies refer to the same external memory, but get their own copy of owned data
+		if ( other.external ) {
+			owned.reset();
+			start = other.start;
+			capacity = other.capacity;
+		} else {
+			owned.reset( other.size > 0 ? new uchar[other.size] : 0 );
+			start = owned.get();
+			capacity = other.size;
+			if ( other.size > 0 ) memcpy( start, other.start, other.size );
+		}
+
+		size = other.size;
+		external = other.external;
+
+		return *this;
+	}
+
+	void VertexDataBuffer::Reserve( size_t bytes )
+	{
+		if ( bytes <= capacity ) return;
+		if ( external ) throw VertexDataOverflowException();
+
+		// The new memory is left uninitialized, since it is written before it is used
+		uchar* memory = new uchar[bytes];
+		if ( size > 0 ) memcpy( memory, start, size );
+
+		owned.reset( memory );
+		start = memory;
+		capacity = bytes;
+	}
+
+	void VertexDataBuffer::Grow( size_t count )
+	{
+		// Grow geometrically so appending stays amortized constant time
+		Reserve( std::max( size + count, capacity * 2 ) );
+	}
+
+	/*
+		Vertex attribute quantization
+	*/
+	ushort floatToHalf( float f )
+	{
+		uint32_t x;
+		memcpy( &x, &f, sizeof( x ) );
+
+		uint sign = ( x >> 16 ) & 0x8000;
+		x &= 0x7FFFFFFF;
+
+		// Infinity and NaN, and numbers that round to a value beyond the half range
+		if ( x >= 0x7F800000 ) return sign | 0x7C00 | ( x > 0x7F800000 ? 0x200 : 0 );
+		if ( x >= 0x477FF000 ) return sign | 0x7C00;
+
+		// Denormals are multiples of 2^-24, rounded to nearest even
+		if ( x < 0x38800000 ) {
+			float a;
+			memcpy( &a, &x, sizeof( a ) );
+			a *= 16777216.0f;
+
+			uint n = (uint)a;
+			float fraction = a - n;
+			if ( fraction > 0.5f || ( fraction == 0.5f && ( n & 1 ) ) ) n++;
+			return sign | n;
+		}
+
+		// Rebias the exponent and round the mantissa to nearest even
+		x += 0xC8000FFF + ( ( x >> 13 ) & 1 );
+		return sign | ( x >> 13 );
+	}
+
+	float halfToFloat( ushort h )
+	{
+		int exponent = ( h >> 10 ) & 0x1F;
+		int mantissa = h & 0x3FF;
+
+		float f;
+		if ( exponent == 0 ) f = ldexp( (float)mantissa, -24 );
+		else if ( exponent == 31 ) f = mantissa ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+		else f = ldexp( (float)( mantissa | 0x400 ), exponent - 25 );
+
+		return ( h & 0x8000 ) ? -f : f;
+	}
+
+	inline int quantizeSnorm( float v, int max )
+	{
+		return (int)floorf( std::min( std::max( v, -1.0f ), 1.0f ) * max + 0.5f );
+	}
+
+	inline int quantizeUnorm( float v, int max )
+	{
+		return (int)floorf( std::min( std::max( v, 0.0f ), 1.0f ) * max + 0.5f );
+	}
+
+	inline uint32_t packNormal2101010( const Vec3& n )
+	{
+		return ( quantizeSnorm( n.X, 511 ) & 0x3FF ) | ( ( quantizeSnorm( n.Y, 511 ) & 0x3FF ) << 10 ) | ( ( quantizeSnorm( n.Z, 511 ) & 0x3FF ) << 20 );
+	}
+
+	inline Vec3 unpackNormal2101010( uint32_t p )
+	{
+		// Sign extend the 10 bit components
+		int x = (int)( p << 22 ) >> 22, y = (int)( p << 12 ) >> 22, z = (int)( p << 2 ) >> 22;
+		return Vec3( std::max( x / 511.0f, -1.0f ), std::max( y / 511.0f, -1.0f ), std::max( z / 511.0f, -1.0f ) );
+	}
+
+	void VertexDataBuffer::Half( float v )
+	{
+		Uint16( floatToHalf( v ) );
+	}
+
+	void VertexDataBuffer::Vec2Half( const GL::Vec2& v )
+	{
+		Half( v.X ); Half( v.Y );
+	}
+
+	void VertexDataBuffer::Vec3Half( const GL::Vec3& v )
+	{
+		Half( v.X ); Half( v.Y ); Half( v.Z ); Half( 1.0f );
+	}
+
+	void VertexDataBuffer::Vec4Half( const GL::Vec4& v )
+	{
+		Half( v.X ); Half( v.Y ); Half( v.Z ); Half( v.W );
+	}
+
+	void VertexDataBuffer::Normal2101010( const GL::Vec3& n )
+	{
+		Uint32( packNormal2101010( n ) );
+	}
+
+	void VertexDataBuffer::Tangent2101010( const GL::Vec4& t )
+	{
+		Uint32( packNormal2101010( GL::Vec3( t.X, t.Y, t.Z ) ) | ( t.W < 0.0f ? 3u << 30 : 1u << 30 ) );
+	}
+
+	void VertexDataBuffer::NormalOctahedral( const GL::Vec3& n )
+	{
+		// Project onto the octahedron and fold the lower hemisphere over the upper one
+		float l = fabsf( n.X ) + fabsf( n.Y ) + fabsf( n.Z );
+		float x = l > 0.0f ? n.X / l : 0.0f, y = l > 0.0f ? n.Y / l : 0.0f;
+
+		if ( n.Z < 0.0f ) {
+			float fx = ( 1.0f - fabsf( y ) ) * ( x >= 0.0f ? 1.0f : -1.0f );
+			float fy = ( 1.0f - fabsf( x ) ) * ( y >= 0.0f ? 1.0f : -1.0f );
+			x = fx;
+			y = fy;
+		}
+
+		Int16( (int16_t)quantizeSnorm( x, 32767 ) );
+		Int16( (int16_t)quantizeSnorm( y, 32767 ) );
+	}
+
+	void VertexDataBuffer::Vec2Unorm16( const GL::Vec2& v )
+	{
+		Uint16( (uint16_t)quantizeUnorm( v.X, 65535 ) );
+		Uint16( (uint16_t)quantizeUnorm( v.Y, 65535 ) );
+	}
+
+	PackError VertexDataBuffer::Pack( const Mesh& mesh )
+	{
+		PackError error = { 0.0f, 0.0f, 0.0f };
+		const Vertex* vertices = mesh.Vertices();
+		uint count = mesh.VertexCount();
+
+		Reserve( size + count * PackedVertex::Stride );
+
+		for ( uint i = 0; i < count; i++ )
+		{
+			const Vertex& v = vertices[i];
+
+			Vec3Half( v.Pos );
+			Normal2101010( v.Normal );
+			Vec2Unorm16( v.Tex );
+
+			// Measure the error by decoding the packed values like the GPU does
+			const float* pos = &v.Pos.X;
+			for ( int c = 0; c < 3; c++ )
+				error.Position = std::max( error.Position, fabsf( halfToFloat( floatToHalf( pos[c] ) ) - pos[c] ) );
+
+			error.Normal = std::max( error.Normal, ( unpackNormal2101010( packNormal2101010( v.Normal ) ) - v.Normal ).Length() );
+
+			error.TexCoord = std::max( error.TexCoord, fabsf( quantizeUnorm( v.Tex.X, 65535 ) / 65535.0f - v.Tex.X ) );
+			error.TexCoord = std::max( error.TexCoord, fabsf( quantizeUnorm( v.Tex.Y, 65535 ) / 65535.0f - v.Tex.Y ) );
+		}
+
+		return error;
+	}
+
 	VertexBuffer::VertexBuffer()
 	{
 		gc.Create( obj, glGenBuffers, glDeleteBuffers );
@@ -40,17 +259,19 @@ namespace GL
 		Data( data, length, usage );
 	}
 
-	VertexBuffer::VertexBuffer( const Mesh& mesh, BufferUsage::buffer_usage_t usage, std::function<void ( const Vertex& v, VertexDataBuffer& data )> f )
+	VertexBuffer::VertexBuffer( const Mesh& mesh, BufferUsage::buffer_usage_t usage )
 	{
-		VertexDataBuffer data;
-		const Vertex* vertices = mesh.Vertices();
-		uint count = mesh.VertexCount();
-
-		for ( uint i = 0; i < count; i++ )
-			f( vertices[i], data );
+		const uint* indices = mesh.Indices();
+		uint count = mesh.IndexCount();
 
 		gc.Create( obj, glGenBuffers, glDeleteBuffers );
-		Data( data.Pointer(), data.Size(), usage );
+
+		if ( mesh.IndexType() == Type::UnsignedShort ) {
+			std::vector<ushort> shortIndices( indices, indices + count );
+			Data( count > 0 ? &shortIndices[0] : 0, count * sizeof( ushort ), usage );
+		} else {
+			Data( indices, count * sizeof( uint ), usage );
+		}
 	}
 
 	VertexBuffer::~VertexBuffer()
@@ -87,5 +308,17 @@ namespace GL
 		glGetBufferSubData( GL_ARRAY_BUFFER, offset, length, data );
 	}
 
+	void* VertexBuffer::MapWrite( size_t offset, size_t length )
+	{
+		glBindBuffer( GL_ARRAY_BUFFER, obj );
+		return glMapBufferRange( GL_ARRAY_BUFFER, offset, length, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT );
+	}
+
+	bool VertexBuffer::Unmap()
+	{
+		glBindBuffer( GL_ARRAY_BUFFER, obj );
+		return glUnmapBuffer( GL_ARRAY_BUFFER ) == GL_TRUE;
+	}
+
 	GC VertexBuffer::gc;
 }
\ No newline at end of file
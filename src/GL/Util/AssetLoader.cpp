@@ -0,0 +1,191 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/AssetLoader.hpp>
+#include <chrono>
+
+namespace GL
+{
+	template <typename T>
+	std::shared_future<std::shared_ptr<const T>> AssetLoader::Load( std::function<std::shared_ptr<const T> ()> load )
+	{
+		std::shared_ptr<std::promise<std::shared_ptr<const T>>> promise( new std::promise<std::shared_ptr<const T>>() );
+		std::shared_future<std::shared_ptr<const T>> future = promise->get_future().share();
+
+		Enqueue( [this, promise, load]() {
+			try {
+				promise->set_value( load() );
+			} catch ( ... ) {
+				promise->set_exception( std::current_exception() );
+			}
+			Finish();
+		} );
+
+		return future;
+	}
+
+	AssetLoader::AssetLoader( uint threads )
+		: pending( 0 ), stopping( false )
+	{
+		if ( threads == 0 ) {
+			uint hardware = std::thread::hardware_concurrency();
+			threads = hardware > 1 ? hardware - 1 : 1;
+		}
+
+		for ( uint i = 0; i < threads; i++ )
+			workers.push_back( std::thread( &AssetLoader::Work, this ) );
+	}
+
+	AssetLoader::~AssetLoader()
+	{
+		// Jobs and uploads are destroyed outside the lock, because dropping
+		// their promises wakes up threads that may be waiting on them
+		std::deque<std::function<void ()>> dropped, droppedUploads;
+
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			stopping = true;
+			dropped.swap( jobs );
+		}
+
+		jobAvailable.notify_all();
+		for ( size_t i = 0; i < workers.size(); i++ )
+			workers[i].join();
+
+		std::lock_guard<std::mutex> lock( mutex );
+		droppedUploads.swap( uploads );
+	}
+
+	std::shared_future<std::shared_ptr<const Mesh>> AssetLoader::QueueMesh( const std::string& filename, MeshOptions::mesh_options_t options )
+	{
+		return Load<Mesh>( [filename, options]() {
+			return std::shared_ptr<const Mesh>( new Mesh( filename, options ) );
+		} );
+	}
+
+	std::shared_future<std::shared_ptr<const Image>> AssetLoader::QueueImage( const std::string& filename )
+	{
+		return Load<Image>( [filename]() {
+			return std::shared_ptr<const Image>( new Image( filename ) );
+		} );
+	}
+
+	std::shared_future<std::shared_ptr<const Mesh>> AssetLoader::QueueMesh( const std::string& filename, MeshOptions::mesh_options_t options, std::function<void ( const Mesh& mesh )> upload )
+	{
+		return Queue<Mesh, std::shared_ptr<const Mesh>>(
+			[filename, options]() { return std::shared_ptr<const Mesh>( new Mesh( filename, options ) ); },
+			[upload]( const std::shared_ptr<const Mesh>& mesh ) { upload( *mesh ); return mesh; }
+		);
+	}
+
+	std::shared_future<std::shared_ptr<const Image>> AssetLoader::QueueImage( const std::string& filename, std::function<void ( const Image& image )> upload )
+	{
+		return Queue<Image, std::shared_ptr<const Image>>(
+			[filename]() { return std::shared_ptr<const Image>( new Image( filename ) ); },
+			[upload]( const std::shared_ptr<const Image>& image ) { upload( *image ); return image; }
+		);
+	}
+
+	std::shared_future<Texture> AssetLoader::QueueTexture( const std::string& filename, InternalFormat::internal_format_t internalFormat, bool mipmaps )
+	{
+		return Queue<Image, Texture>(
+			[filename]() { return std::shared_ptr<const Image>( new Image( filename ) ); },
+			[internalFormat, mipmaps]( const std::shared_ptr<const Image>& image ) {
+				Texture texture( *image, internalFormat );
+				if ( mipmaps ) texture.GenerateMipmaps();
+				return texture;
+			}
+		);
+	}
+
+	uint AssetLoader::Update( float budget )
+	{
+		typedef std::chrono::steady_clock clock;
+		clock::time_point start = clock::now();
+		uint finished = 0;
+
+		do {
+			std::function<void ()> upload;
+
+			{
+				std::lock_guard<std::mutex> lock( mutex );
+				if ( uploads.empty() ) break;
+				upload.swap( uploads.front() );
+				uploads.pop_front();
+			}
+
+			upload();
+			Finish();
+			finished++;
+		} while ( std::chrono::duration<float>( clock::now() - start ).count() < budget );
+
+		return finished;
+	}
+
+	uint AssetLoader::Pending() const
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		return pending;
+	}
+
+	void AssetLoader::Work()
+	{
+		for ( ;; ) {
+			std::function<void ()> job;
+
+			{
+				std::unique_lock<std::mutex> lock( mutex );
+				while ( !stopping && jobs.empty() )
+					jobAvailable.wait( lock );
+				if ( stopping ) return;
+
+				job.swap( jobs.front() );
+				jobs.pop_front();
+			}
+
+			job();
+		}
+	}
+
+	void AssetLoader::Enqueue( std::function<void ()> job )
+	{
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			jobs.push_back( job );
+			pending++;
+		}
+
+		jobAvailable.notify_one();
+	}
+
+	void AssetLoader::EnqueueUpload( std::function<void ()> upload )
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		uploads.push_back( upload );
+	}
+
+	void AssetLoader::Finish()
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		pending--;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/BVH.hpp>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <limits>
+
+namespace GL
+{
+	/*
+		Internal BVH construction facilities
+	*/
+	const uint BVH_BINS = 16;
+
+	// Subtrees with more triangles than this are built on their own thread
+	const uint BVH_PARALLEL_SIZE = 16 * 1024;
+
+	// Deeper nodes become leaves, which bounds the traversal stack size
+	const int BVH_MAX_DEPTH = 62;
+	const int BVH_STACK_SIZE = BVH_MAX_DEPTH + 2;
+
+	struct BVH::buildContext
+	{
+		std::vector<AABB> bounds;
+		std::vector<Vec3> centroids;
+		std::atomic<uint> nodeCount;
+		uint maxLeafSize;
+		int threadDepth;
+	};
+
+	struct bvhBin
+	{
+		AABB bounds;
+		uint count;
+	};
+
+	inline float axisOf( const Vec3& v, int axis )
+	{
+		return ( &v.X )[axis];
+	}
+
+	inline uint binOf( float c, float min, float scale )
+	{
+		return std::min( BVH_BINS - 1, (uint)( ( c - min ) * scale ) );
+	}
+
+	BVH::BVH( const Mesh& mesh, uint maxLeafSize )
+	{
+		const Vertex* vertices = mesh.Vertices();
+		const uint* indices = mesh.Indices();
+		uint triCount = ( mesh.IsIndexed() ? mesh.IndexCount() : mesh.VertexCount() ) / 3;
+
+		buildContext context;
+		context.bounds.resize( triCount );
+		context.centroids.resize( triCount );
+		context.nodeCount = 1;
+		context.maxLeafSize = std::max( maxLeafSize, 1u );
+
+		context.threadDepth = 0;
+		while ( ( 1u << context.threadDepth ) < std::thread::hardware_concurrency() ) context.threadDepth++;
+
+		positions.resize( triCount * 3 );
+		for ( uint t = 0; t < triCount; t++ )
+		{
+			for ( uint k = 0; k < 3; k++ )
+			{
+				positions[t * 3 + k] = vertices[indices ? indices[t * 3 + k] : t * 3 + k].Pos;
+				context.bounds[t].Extend( positions[t * 3 + k] );
+			}
+			context.centroids[t] = context.bounds[t].Center();
+		}
+
+		triangles.resize( triCount );
+		for ( uint t = 0; t < triCount; t++ )
+			triangles[t] = t;
+
+		// A binary tree with a triangle per leaf has at most 2n - 1 nodes
+		nodes.resize( std::max( triCount * 2, 2u ) - 1 );
+		Build( context, 0, 0, triCount, 0 );
+		nodes.resize( context.nodeCount );
+
+		// Store the vertices in tree order so leaves read contiguous memory
+		std::vector<Vec3> ordered( positions.size() );
+		for ( uint i = 0; i < triCount; i++ )
+			std::copy( &positions[triangles[i] * 3], &positions[triangles[i] * 3] + 3, &ordered[i * 3] );
+		positions.swap( ordered );
+	}
+
+	void BVH::Build( buildContext& context, uint index, uint first, uint count, int depth )
+	{
+		node& n = nodes[index];
+		n.bounds = AABB();
+		n.left = 0;
+		n.first = first;
+		n.count = count;
+
+		AABB centroidBounds;
+		for ( uint i = first; i < first + count; i++ )
+		{
+			n.bounds.Extend( context.bounds[triangles[i]] );
+			centroidBounds.Extend( context.centroids[triangles[i]] );
+		}
+
+		if ( count <= context.maxLeafSize || depth >= BVH_MAX_DEPTH ) return;
+
+		// Find the cheapest split between bins along any axis
+		float bestCost = std::numeric_limits<float>::max();
+		int bestAxis = -1;
+		uint bestSplit = 0;
+
+		for ( int axis = 0; axis < 3; axis++ )
+		{
+			float min = axisOf( centroidBounds.Min, axis );
+			float extent = axisOf( centroidBounds.Max, axis ) - min;
+			if ( extent <= 0.0f ) continue;
+
+			float scale = BVH_BINS / extent;
+			bvhBin bins[BVH_BINS];
+			for ( uint b = 0; b < BVH_BINS; b++ ) bins[b].count = 0;
+
+			for ( uint i = first; i < first + count; i++ )
+			{
+				uint t = triangles[i];
+				bvhBin& bin = bins[binOf( axisOf( context.centroids[t], axis ), min, scale )];
+				bin.bounds.Extend( context.bounds[t] );
+				bin.count++;
+			}
+
+			// Sweep from the right to get the cost of everything right of each split
+			float rightCost[BVH_BINS];
+			AABB right;
+			uint rightCount = 0;
+			for ( uint b = BVH_BINS - 1; b > 0; b-- )
+			{
+				right.Extend( bins[b].bounds );
+				rightCount += bins[b].count;
+				rightCost[b] = rightCount > 0 ? right.SurfaceArea() * rightCount : 0.0f;
+			}
+
+			AABB left;
+			uint leftCount = 0;
+			for ( uint b = 0; b < BVH_BINS - 1; b++ )
+			{
+				left.Extend( bins[b].bounds );
+				leftCount += bins[b].count;
+				if ( leftCount == 0 || leftCount == count ) continue;
+
+				float cost = left.SurfaceArea() * leftCount + rightCost[b + 1];
+				if ( cost < bestCost ) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b;
+				}
+			}
+		}
+
+		// All centroids coincide, so there is nothing to split
+		if ( bestAxis < 0 ) return;
+
+		float min = axisOf( centroidBounds.Min, bestAxis );
+		float scale = BVH_BINS / ( axisOf( centroidBounds.Max, bestAxis ) - min );
+		uint* middle = std::partition( &triangles[first], &triangles[first] + count, [&] ( uint t ) {
+			return binOf( axisOf( context.centroids[t], bestAxis ), min, scale ) <= bestSplit;
+		} );
+		uint leftCount = middle - &triangles[first];
+
+		// Children are allocated in pairs, the subtrees work on disjoint triangle ranges
+		uint left = context.nodeCount.fetch_add( 2 );
+		n.left = left;
+
+		if ( count > BVH_PARALLEL_SIZE && depth < context.threadDepth ) {
+			std::thread thread( [&, left, first, leftCount, depth] () {
+				Build( context, left, first, leftCount, depth + 1 );
+			} );
+			Build( context, left + 1, first + leftCount, count - leftCount, depth + 1 );
+			thread.join();
+		} else {
+			Build( context, left, first, leftCount, depth + 1 );
+			Build( context, left + 1, first + leftCount, count - leftCount, depth + 1 );
+		}
+	}
+
+	const AABB& BVH::Bounds() const
+	{
+		return nodes[0].bounds;
+	}
+
+	int BVH::NodeCount() const
+	{
+		return nodes.size();
+	}
+
+	/*
+		Traversal
+	*/
+	// Distances along the ray between the two planes of a slab, a ray that
+	// runs along one of the planes is inside the slab at any distance
+	inline void slabRange( float min, float max, float origin, float invDir, float& t0, float& t1 )
+	{
+		float a = ( min - origin ) * invDir, b = ( max - origin ) * invDir;
+
+		if ( a != a || b != b ) {
+			t0 = -std::numeric_limits<float>::infinity();
+			t1 = std::numeric_limits<float>::infinity();
+		} else {
+			t0 = std::min( a, b );
+			t1 = std::max( a, b );
+		}
+	}
+
+	inline bool slabTest( const AABB& box, const Vec3& origin, const Vec3& invDir, bool axisParallel, float maxDistance, float& tmin )
+	{
+		float tx0 = ( box.Min.X - origin.X ) * invDir.X, tx1 = ( box.Max.X - origin.X ) * invDir.X;
+		float ty0 = ( box.Min.Y - origin.Y ) * invDir.Y, ty1 = ( box.Max.Y - origin.Y ) * invDir.Y;
+		float tz0 = ( box.Min.Z - origin.Z ) * invDir.Z, tz1 = ( box.Max.Z - origin.Z ) * invDir.Z;
+
+		tmin = std::max( std::max( std::min( tx0, tx1 ), std::min( ty0, ty1 ) ), std::max( std::min( tz0, tz1 ), 0.0f ) );
+		float tmax = std::min( std::min( std::max( tx0, tx1 ), std::max( ty0, ty1 ) ), std::min( std::max( tz0, tz1 ), maxDistance ) );
+
+		if ( tmin <= tmax ) return true;
+		if ( !axisParallel ) return false;
+
+		// A zero direction gives 0 * inf = NaN for an origin on a plane of the
+		// box, which makes the test above miss, so such misses are checked again
+		slabRange( box.Min.X, box.Max.X, origin.X, invDir.X, tx0, tx1 );
+		slabRange( box.Min.Y, box.Max.Y, origin.Y, invDir.Y, ty0, ty1 );
+		slabRange( box.Min.Z, box.Max.Z, origin.Z, invDir.Z, tz0, tz1 );
+
+		tmin = std::max( std::max( tx0, ty0 ), std::max( tz0, 0.0f ) );
+		tmax = std::min( std::min( tx1, ty1 ), std::min( tz1, maxDistance ) );
+
+		return tmin <= tmax;
+	}
+
+	bool BVH::Intersect( const Ray& ray, RayHit& hit, float maxDistance ) const
+	{
+		if ( triangles.empty() ) return false;
+
+		Vec3 invDir( 1.0f / ray.Direction.X, 1.0f / ray.Direction.Y, 1.0f / ray.Direction.Z );
+		bool axisParallel = ray.Direction.X == 0.0f || ray.Direction.Y == 0.0f || ray.Direction.Z == 0.0f;
+		bool found = false;
+
+		uint stack[BVH_STACK_SIZE];
+		int size = 0;
+		float t;
+		if ( slabTest( nodes[0].bounds, ray.Origin, invDir, axisParallel, maxDistance, t ) ) stack[size++] = 0;
+
+		while ( size > 0 )
+		{
+			const node& n = nodes[stack[--size]];
+
+			if ( n.left == 0 ) {
+				for ( uint i = n.first; i < n.first + n.count; i++ )
+				{
+					float u, v;
+					const Vec3* p = &positions[i * 3];
+					if ( ray.Intersects( p[0], p[1], p[2], t, u, v ) && t >= 0.0f && t < maxDistance ) {
+						maxDistance = t;
+						hit.Triangle = triangles[i];
+						hit.Distance = t;
+						hit.U = u;
+						hit.V = v;
+						found = true;
+					}
+				}
+				continue;
+			}
+
+			// Visit the nearest child first, so hits in it can skip the other one
+			float t0, t1;
+			bool hit0 = slabTest( nodes[n.left].bounds, ray.Origin, invDir, axisParallel, maxDistance, t0 );
+			bool hit1 = slabTest( nodes[n.left + 1].bounds, ray.Origin, invDir, axisParallel, maxDistance, t1 );
+
+			if ( hit0 && hit1 ) {
+				stack[size++] = t0 <= t1 ? n.left + 1 : n.left;
+				stack[size++] = t0 <= t1 ? n.left : n.left + 1;
+			} else if ( hit0 ) {
+				stack[size++] = n.left;
+			} else if ( hit1 ) {
+				stack[size++] = n.left + 1;
+			}
+		}
+
+		return found;
+	}
+
+	void BVH::Query( const Frustum& frustum, std::vector<uint>& result ) const
+	{
+		if ( triangles.empty() ) return;
+
+		uint stack[BVH_STACK_SIZE];
+		int size = 0;
+		stack[size++] = 0;
+
+		while ( size > 0 )
+		{
+			const node& n = nodes[stack[--size]];
+			if ( !frustum.Intersects( n.bounds ) ) continue;
+
+			// Subtrees entirely inside the frustum are added without visiting them
+			if ( frustum.Contains( n.bounds ) ) {
+				result.insert( result.end(), &triangles[n.first], &triangles[n.first] + n.count );
+			} else if ( n.left == 0 ) {
+				for ( uint i = n.first; i < n.first + n.count; i++ )
+				{
+					AABB box;
+					box.Extend( positions[i * 3] );
+					box.Extend( positions[i * 3 + 1] );
+					box.Extend( positions[i * 3 + 2] );
+					if ( frustum.Intersects( box ) ) result.push_back( triangles[i] );
+				}
+			} else {
+				stack[size++] = n.left;
+				stack[size++] = n.left + 1;
+			}
+		}
+	}
+}
\ No newline at end of file
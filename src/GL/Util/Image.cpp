@@ -25,6 +25,7 @@
 #endif
 
 #include <GL/Util/Image.hpp>
+#include <GL/Util/MappedFile.hpp>
 #include <GL/Util/libjpeg/jpeglib.h>
 #include <GL/Util/libpng/png.h>
 #include <fstream>
@@ -92,21 +93,9 @@ namespace GL
 		width = 0;
 		height = 0;
 
-		// Load data from memory
-		ByteReader data( size, true );
-		std::memcpy( data.Data(), pixels, size );
-
-		// Determine format and process
-		if ( data.PeekByte( 0 ) == 'B' && data.PeekByte( 1 ) == 'M' )
-			LoadBMP( data );
-		else if ( data.Compare( data.Length() - 18, 18, (const uchar*)"TRUEVISION-XFILE." ) )
-			LoadTGA( data );
-		else if ( data.PeekByte( 0 ) == 0xFF && data.PeekByte( 1 ) == 0xD8 )
-			LoadJPEG( data );
-		else if ( data.Compare( 0, 4, (const uchar*)"\x89PNG" ) )
-			LoadPNG( data );
-		else
-			throw FormatException();
+		// Decode directly from the caller's memory
+		ByteReader data( pixels, size, true );
+		Load( data );
 	}
 
 	void Image::Load( const std::string& filename )
@@ -117,17 +106,15 @@ namespace GL
 		width = 0;
 		height = 0;
 
-		// Load data from file
-		std::ifstream file( filename.c_str(), std::ios::binary | std::ios::ate );
-		if ( !file.is_open() ) throw FileException();
-
-		uint fileSize = (uint)file.tellg();
-		file.seekg( 0, std::ios::beg );
+		// Decode directly from the mapped file
+		MappedFile file( filename );
+		ByteReader data( file.Data(), file.Length(), true );
+		Load( data );
+	}
 
-		ByteReader data( fileSize, true );
-		file.read( (char*)data.Data(), fileSize );
-		
-		file.close();
+	void Image::Load( ByteReader& data )
+	{
+		if ( data.Length() < 4 ) throw FormatException();
 
 		// Determine format and process
 		if ( data.PeekByte( 0 ) == 'B' && data.PeekByte( 1 ) == 'M' )
@@ -0,0 +1,125 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/MappedFile.hpp>
+#include <fstream>
+
+#if defined( OOGL_PLATFORM_LINUX ) || defined( OOGL_PLATFORM_OSX )
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace GL
+{
+	MappedFile::MappedFile( const std::string& filename )
+	{
+		data = 0;
+		length = 0;
+		mapped = false;
+
+#if defined( OOGL_PLATFORM_WINDOWS )
+		mapping = NULL;
+		file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+		if ( file == INVALID_HANDLE_VALUE ) throw FileException();
+
+		LARGE_INTEGER size;
+		if ( GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+		{
+			mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+			if ( mapping != NULL )
+			{
+				data = (const uchar*)MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+				if ( data != NULL ) {
+					length = (size_t)size.QuadPart;
+					mapped = true;
+					return;
+				}
+
+				CloseHandle( mapping );
+				mapping = NULL;
+			}
+		}
+
+		CloseHandle( file );
+		file = INVALID_HANDLE_VALUE;
+#elif defined( OOGL_PLATFORM_LINUX ) || defined( OOGL_PLATFORM_OSX )
+		int fd = open( filename.c_str(), O_RDONLY );
+		if ( fd == -1 ) throw FileException();
+
+		struct stat info;
+		if ( fstat( fd, &info ) == 0 && S_ISREG( info.st_mode ) && info.st_size > 0 )
+		{
+			void* view = mmap( 0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+			if ( view != MAP_FAILED ) {
+				madvise( view, info.st_size, MADV_SEQUENTIAL );
+
+				data = (const uchar*)view;
+				length = info.st_size;
+				mapped = true;
+			}
+		}
+
+		close( fd );
+		if ( mapped ) return;
+#endif
+
+		// Fall back to buffered reading
+		Read( filename );
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if ( !mapped ) return;
+
+#if defined( OOGL_PLATFORM_WINDOWS )
+		UnmapViewOfFile( data );
+		CloseHandle( mapping );
+		CloseHandle( file );
+#elif defined( OOGL_PLATFORM_LINUX ) || defined( OOGL_PLATFORM_OSX )
+		munmap( (void*)data, length );
+#endif
+	}
+
+	const uchar* MappedFile::Data() const
+	{
+		return data;
+	}
+
+	size_t MappedFile::Length() const
+	{
+		return length;
+	}
+
+	void MappedFile::Read( const std::string& filename )
+	{
+		std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate );
+		if ( !file.is_open() ) throw FileException();
+
+		length = (size_t)file.tellg();
+		file.seekg( 0, std::ios::beg );
+
+		buffer.resize( length );
+		if ( length > 0 ) file.read( (char*)&buffer[0], length );
+		data = length > 0 ? &buffer[0] : 0;
+	}
+}
\ No newline at end of file
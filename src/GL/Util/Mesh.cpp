@@ -20,217 +20,1328 @@
 */
 
 #include <GL/Util/Mesh.hpp>
+#include <GL/Util/MappedFile.hpp>
+#include <GL/Util/NumberScanner.hpp>
 #include <GL/Math/Vec3.hpp>
 #include <fstream>
+#include <unordered_map>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <climits>
+#include <cfloat>
+#include <cmath>
+#include <sstream>
+#include <locale>
+#include <limits>
+#include <atomic>
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined( OOGL_PLATFORM_LINUX ) || defined( OOGL_PLATFORM_OSX )
+	#include <unistd.h>
+#endif
 
 namespace GL
 {
 	/*
 		Internal OBJ parsing facilities
 	*/
-	enum mode
-	{
-		MODE_NONE,
-		MODE_UNKNOWN,
-		MODE_VERTEX,
-		MODE_NORMAL,
-		MODE_TEXTURE,
-		MODE_FACE
+	struct faceVertex
+	{
+		int v, t, n;
+
+		bool operator==( const faceVertex& o ) const
+		{
+			return v == o.v && t == o.t && n == o.n;
+		}
+	};
+
+	struct faceVertexHash
+	{
+		size_t operator()( const faceVertex& fv ) const
+		{
+			return ( (size_t)fv.v * 73856093 ) ^ ( (size_t)fv.t * 19349663 ) ^ ( (size_t)fv.n * 83492791 );
+		}
+	};
+
+	// Corner with relative indices, which are resolved against the attribute
+	// counts of its own chunk and have to be offset when chunks are merged
+	struct relativeCorner
+	{
+		size_t corner;
+		bool v, t, n;
 	};
 
-	struct face
+	// Material selected for the corners starting at the given one
+	struct materialUse
 	{
-		int v1, v2, v3;
-		int t1, t2, t3;
-		int n1, n2, n3;
+		size_t corner;
+		std::string name;
 	};
 
+	// Attributes and triangle corners parsed from (a part of) an OBJ file,
+	// missing texture coordinate and normal indices are 0
+	struct objData
+	{
+		std::vector<Vec3> vectors;
+		std::vector<Vec3> normals;
+		std::vector<Vec2> texcoords;
+		std::vector<faceVertex> corners;
+		std::vector<relativeCorner> relative;
+		std::vector<materialUse> materialUses;
+		std::vector<std::string> libraries;
+	};
+
+	// Files are only split into chunks for parallel parsing if every thread gets at least this many bytes
+	const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+	// Amount of the file read at once when streaming, lines longer than this grow the window
+	const size_t STREAM_WINDOW_SIZE = 256 * 1024;
+
 	inline bool IS_SPACING( char c )
 	{
-		return c == ' ' || c == '\n' || c == '\t';
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	inline const char* skipSpacing( const char* buf, const char* end )
+	{
+		while ( buf < end && IS_SPACING( *buf ) ) buf++;
+		return buf;
+	}
+
+	void readVector( const char* buf, const char* end, Vec3& out )
+	{
+		out = Vec3();
+		buf = skipSpacing( buf, end );
+		buf += Internal::readFloat( buf, end, out.X );
+		buf = skipSpacing( buf, end );
+		buf += Internal::readFloat( buf, end, out.Y );
+		buf = skipSpacing( buf, end );
+		buf += Internal::readFloat( buf, end, out.Z );
 	}
 
-	inline int readInt( char* buf, int& out )
+	// Reads a corner in any of the v, v/t, v//n and v/t/n forms
+	int readCorner( const char* buf, const char* end, faceVertex& out )
 	{
-		// Determine length and sign of number
-		int l = 0;
-		bool neg = false;
-		if ( buf[0] == '-' ) { neg = true; buf++; }
-		while ( buf[l] >= '0' && buf[l] <= '9' ) l++;
+		const char* p = buf;
+		out.v = out.t = out.n = 0;
+
+		int len = Internal::readInt( p, end, out.v );
+		if ( out.v == 0 ) return 0;
+		p += len;
 
-		// Multiply each digit by the appropriate power of 10
-		int n = 0;
-		int p = 1;
-		for ( int i = l - 1; i >= 0; i-- ) {
-			n += ( buf[i] - '0' ) * p;
-			p *= 10;
+		if ( p < end && *p == '/' ) {
+			p += Internal::readInt( p + 1, end, out.t ) + 1;
+			if ( p < end && *p == '/' )
+				p += Internal::readInt( p + 1, end, out.n ) + 1;
 		}
 
-		// Handle sign
-		if ( neg ) {
-			out = -n;
-			l++;
-		} else
-			out = n;
+		return p - buf;
+	}
+
+	inline int resolveIndex( int index, size_t count, bool& relative )
+	{
+		relative = index < 0;
+		return relative ? (int)count + index + 1 : index;
+	}
+
+	void addCorner( const faceVertex& corner, objData& out )
+	{
+		out.corners.push_back( corner );
+		faceVertex& c = out.corners.back();
 
-		return l;
+		relativeCorner rel = { out.corners.size() - 1, false, false, false };
+		c.v = resolveIndex( c.v, out.vectors.size(), rel.v );
+		c.t = resolveIndex( c.t, out.texcoords.size(), rel.t );
+		c.n = resolveIndex( c.n, out.normals.size(), rel.n );
+
+		if ( rel.v || rel.t || rel.n ) out.relative.push_back( rel );
 	}
 
-	inline int readFloat( char* buf, float& out )
+	// Polygons are triangulated as a fan around their first corner
+	void readFace( const char* buf, const char* end, objData& out )
 	{
-		// Read natural part
-		bool neg = buf[0] == '-';
-		int nat, frac;
-		int ln = readInt( buf, nat );
+		faceVertex first, prev, corner;
+		int count = 0;
 
-		// Read fractional part
-		buf += ln + 1;
-		int lf = readInt( buf, frac );
-		int p = 1;
-		for ( int i = 0; i < lf; i++ ) p *= 10;
+		while ( true )
+		{
+			buf = skipSpacing( buf, end );
+			int len = readCorner( buf, end, corner );
+			if ( len == 0 ) break;
+			buf += len;
 
-		// Handle sign
-		if ( neg )
-			out = nat - frac / (float)p;
-		else
-			out = nat + frac / (float)p;
+			if ( count == 0 ) {
+				first = corner;
+			} else if ( count >= 2 ) {
+				addCorner( first, out );
+				addCorner( prev, out );
+				addCorner( corner, out );
+			}
 
-		return ln + lf + 1;
+			prev = corner;
+			count++;
+		}
 	}
 
-	int readVector( char* buf, Vec3& out )
+	inline bool isCommand( const char* buf, const char* end, const char* command, size_t length )
 	{
-		int i = 0;
-		while ( IS_SPACING( *buf ) ) { buf++; i++; };
-		buf += readFloat( buf, out.X );
-		while ( IS_SPACING( *buf ) ) { buf++; i++; }
-		buf += readFloat( buf, out.Y );
-		while ( IS_SPACING( *buf ) ) { buf++; i++; }
-		buf += readFloat( buf, out.Z );
-		return i;
+		return (size_t)( end - buf ) > length && memcmp( buf, command, length ) == 0 && IS_SPACING( buf[length] );
 	}
 
-	int readFace( char* buf, face& out )
+	// Names run until the end of the line, file names until the next space
+	std::string readName( const char* buf, const char* end )
 	{
-		int i = 0;
-		while ( IS_SPACING( *buf ) ) { buf++; i++; };
-		buf += readInt( buf, out.v1 ) + 1;
-		buf += readInt( buf, out.t1 ) + 1;
-		buf += readInt( buf, out.n1 ) + 1;
-		while ( IS_SPACING( *buf ) ) { buf++; i++; }
-		buf += readInt( buf, out.v2 ) + 1;
-		buf += readInt( buf, out.t2 ) + 1;
-		buf += readInt( buf, out.n2 ) + 1;
-		while ( IS_SPACING( *buf ) ) { buf++; i++; }
-		buf += readInt( buf, out.v3 ) + 1;
-		buf += readInt( buf, out.t3 ) + 1;
-		buf += readInt( buf, out.n3 ) + 1;
-		return i;
+		buf = skipSpacing( buf, end );
+		while ( end > buf && IS_SPACING( end[-1] ) ) end--;
+		return std::string( buf, end );
 	}
 
-	Mesh::Mesh( const std::string& filename )
+	void readFileNames( const char* buf, const char* end, std::vector<std::string>& out )
 	{
-		// Read file into memory
-		std::ifstream file( filename.c_str(), std::ios::in | std::ios::ate );
-		if ( !file.is_open() ) throw FileException();
-		unsigned int fileLen = (unsigned int)file.tellg();
-		file.seekg( 0, std::ios::beg );
-		std::vector<char> buf( fileLen );
-		file.read( &buf[0], fileLen );
-		file.close();
+		while ( ( buf = skipSpacing( buf, end ) ) < end )
+		{
+			const char* name = buf;
+			while ( buf < end && !IS_SPACING( *buf ) ) buf++;
+			out.push_back( std::string( name, buf ) );
+		}
+	}
 
-		// Data
-		int approxMem = 295 + fileLen / 1024 * 11;
-		std::vector<Vec3> vectors; vectors.reserve( approxMem );
-		std::vector<Vec3> normals; normals.reserve( approxMem );
-		std::vector<Vec2> texcoords; texcoords.reserve( approxMem );
-		vertices.reserve( approxMem );
+	void parseLine( const char* buf, const char* end, objData& out )
+	{
+		buf = skipSpacing( buf, end );
+		if ( end - buf < 2 ) return;
 
-		// Parser state
-		bool inComment = false;
-		int mode = MODE_NONE;
+		// Comments and unsupported commands are ignored
 		Vec3 v3;
-		face f;
+		if ( buf[0] == 'v' && IS_SPACING( buf[1] ) ) {
+			readVector( buf + 2, end, v3 );
+			out.vectors.push_back( v3 );
+		} else if ( buf[0] == 'v' && buf[1] == 'n' ) {
+			readVector( buf + 2, end, v3 );
+			out.normals.push_back( v3 );
+		} else if ( buf[0] == 'v' && buf[1] == 't' ) {
+			readVector( buf + 2, end, v3 );
+			out.texcoords.push_back( Vec2( v3.X, v3.Y ) );
+		} else if ( buf[0] == 'f' && IS_SPACING( buf[1] ) ) {
+			readFace( buf + 2, end, out );
+		} else if ( isCommand( buf, end, "usemtl", 6 ) ) {
+			materialUse use = { out.corners.size(), readName( buf + 7, end ) };
+			out.materialUses.push_back( use );
+		} else if ( isCommand( buf, end, "mtllib", 6 ) ) {
+			readFileNames( buf + 7, end, out.libraries );
+		}
+	}
 
-		// Parse
-		for ( unsigned int i = 0; i < fileLen; i++ )
+	void parseChunk( const char* buf, const char* end, objData& out )
+	{
+		while ( buf < end )
 		{
-			// Ignore comment lines
-			if ( buf[i] == '#' ) {
-				inComment = true;
-				continue;
-			} else if ( inComment && buf[i] != '\n' ) {
-				continue;
-			} else if ( inComment && buf[i] == '\n' ) {
-				inComment = false;
+			const char* eol = (const char*)memchr( buf, '\n', end - buf );
+			if ( !eol ) eol = end;
+
+			parseLine( buf, eol, out );
+			buf = eol + 1;
+		}
+	}
+
+	// Missing attributes are left zero, references to attributes that don't exist are errors
+	inline Vertex makeVertex( const objData& data, const faceVertex& corner )
+	{
+		if ( corner.v < 1 || (size_t)corner.v > data.vectors.size() ||
+			corner.t < 0 || (size_t)corner.t > data.texcoords.size() ||
+			corner.n < 0 || (size_t)corner.n > data.normals.size() )
+			throw MeshFormatException();
+
+		Vertex vertex = {
+			data.vectors[corner.v - 1],
+			corner.t ? data.texcoords[corner.t - 1] : Vec2(),
+			corner.n ? data.normals[corner.n - 1] : Vec3()
+		};
+		return vertex;
+	}
+
+	template <typename T>
+	void copyChunk( const std::vector<T>& src, std::vector<T>& dst, size_t offset )
+	{
+		if ( !src.empty() ) std::copy( src.begin(), src.end(), dst.begin() + offset );
+	}
+
+	void parseParallel( const char* buf, const char* end, objData& out, uint maxThreads )
+	{
+		// Determine amount of chunks
+		size_t length = end - buf;
+		if ( maxThreads == 0 ) maxThreads = std::thread::hardware_concurrency();
+		size_t chunkCount = std::min<size_t>( maxThreads, length / MIN_CHUNK_SIZE );
+
+		if ( chunkCount < 2 ) {
+			parseChunk( buf, end, out );
+			return;
+		}
+
+		// Split buffer at line boundaries
+		std::vector<const char*> bounds( chunkCount + 1 );
+		bounds[0] = buf;
+		bounds[chunkCount] = end;
+
+		for ( size_t i = 1; i < chunkCount; i++ )
+		{
+			const char* p = std::max( buf + length * i / chunkCount, bounds[i-1] );
+			const char* eol = (const char*)memchr( p, '\n', end - p );
+			bounds[i] = eol ? eol + 1 : end;
+		}
+
+		// Parse chunks
+		std::vector<objData> chunks( chunkCount );
+		std::vector<std::thread> threads;
+
+		for ( size_t i = 0; i < chunkCount; i++ )
+			threads.push_back( std::thread( parseChunk, bounds[i], bounds[i+1], std::ref( chunks[i] ) ) );
+		for ( size_t i = 0; i < chunkCount; i++ )
+			threads[i].join();
+
+		// Each chunk is merged at the offset given by the prefix sum of the element counts before it
+		std::vector<size_t> vectorOffset( chunkCount + 1, 0 ), normalOffset( chunkCount + 1, 0 );
+		std::vector<size_t> texcoordOffset( chunkCount + 1, 0 ), cornerOffset( chunkCount + 1, 0 );
+
+		for ( size_t i = 0; i < chunkCount; i++ )
+		{
+			vectorOffset[i+1] = vectorOffset[i] + chunks[i].vectors.size();
+			normalOffset[i+1] = normalOffset[i] + chunks[i].normals.size();
+			texcoordOffset[i+1] = texcoordOffset[i] + chunks[i].texcoords.size();
+			cornerOffset[i+1] = cornerOffset[i] + chunks[i].corners.size();
+		}
+
+		out.vectors.resize( vectorOffset[chunkCount] );
+		out.normals.resize( normalOffset[chunkCount] );
+		out.texcoords.resize( texcoordOffset[chunkCount] );
+		out.corners.resize( cornerOffset[chunkCount] );
+
+		threads.clear();
+		for ( size_t i = 0; i < chunkCount; i++ )
+		{
+			threads.push_back( std::thread( [&, i] () {
+				copyChunk( chunks[i].vectors, out.vectors, vectorOffset[i] );
+				copyChunk( chunks[i].normals, out.normals, normalOffset[i] );
+				copyChunk( chunks[i].texcoords, out.texcoords, texcoordOffset[i] );
+				copyChunk( chunks[i].corners, out.corners, cornerOffset[i] );
+
+				for ( size_t j = 0; j < chunks[i].relative.size(); j++ )
+				{
+					const relativeCorner& rel = chunks[i].relative[j];
+					faceVertex& c = out.corners[cornerOffset[i] + rel.corner];
+					if ( rel.v ) c.v += (int)vectorOffset[i];
+					if ( rel.t ) c.t += (int)texcoordOffset[i];
+					if ( rel.n ) c.n += (int)normalOffset[i];
+				}
+			} ) );
+		}
+		for ( size_t i = 0; i < chunkCount; i++ )
+			threads[i].join();
+
+		for ( size_t i = 0; i < chunkCount; i++ )
+		{
+			for ( size_t j = 0; j < chunks[i].materialUses.size(); j++ )
+			{
+				out.materialUses.push_back( chunks[i].materialUses[j] );
+				out.materialUses.back().corner += cornerOffset[i];
+			}
+			out.libraries.insert( out.libraries.end(), chunks[i].libraries.begin(), chunks[i].libraries.end() );
+		}
+	}
+
+	/*
+		Normal generation
+
+		Positions closer together than a small fraction of the mesh size are
+		welded with a spatial hash first, so that duplicated vertices along
+		seams still get smooth normals. Every corner without a normal then
+		gets the average of the normals of the faces around its position,
+		weighted by their angle at that position, leaving out faces that are
+		bent away from its own face by more than the crease angle.
+	*/
+	const float WELD_TOLERANCE = 1e-6f;
+
+	inline int64_t weldCell( float v, float cellSize )
+	{
+		double c = floor( (double)v / cellSize );
+		return (int64_t)std::min( std::max( c, -1e15 ), 1e15 );
+	}
+
+	// Gives every position the number of the first position within the tolerance of it
+	void weldPositions( const std::vector<Vec3>& positions, std::vector<uint>& weld )
+	{
+		AABB bounds;
+		for ( size_t i = 0; i < positions.size(); i++ )
+			bounds.Extend( positions[i] );
+
+		Vec3 size = bounds.Size();
+		float extent = std::max( std::max( size.X, size.Y ), size.Z );
+		float tolerance = extent > 0.0f && extent < FLT_MAX ? extent * WELD_TOLERANCE : 1.0f;
+
+		// Cells are twice as large as the tolerance, so positions within the
+		// tolerance of a point are in its own cell or the neighbours it is closest to
+		float cellSize = tolerance * 2.0f;
+		std::unordered_map<uint64_t, uint> cells( positions.size() );
+		std::vector<uint> next( positions.size(), (uint)-1 );
+		weld.resize( positions.size() );
+
+		for ( size_t i = 0; i < positions.size(); i++ )
+		{
+			const Vec3& p = positions[i];
+			int64_t cx = weldCell( p.X, cellSize ), cy = weldCell( p.Y, cellSize ), cz = weldCell( p.Z, cellSize );
+			int64_t nx = weldCell( p.X + tolerance, cellSize ) > cx ? 1 : weldCell( p.X - tolerance, cellSize ) < cx ? -1 : 0;
+			int64_t ny = weldCell( p.Y + tolerance, cellSize ) > cy ? 1 : weldCell( p.Y - tolerance, cellSize ) < cy ? -1 : 0;
+			int64_t nz = weldCell( p.Z + tolerance, cellSize ) > cz ? 1 : weldCell( p.Z - tolerance, cellSize ) < cz ? -1 : 0;
+			weld[i] = (uint)i;
+
+			for ( int n = 0; n < 8 && weld[i] == i; n++ )
+			{
+				if ( ( ( n & 1 ) && !nx ) || ( ( n & 2 ) && !ny ) || ( ( n & 4 ) && !nz ) ) continue;
+
+				uint64_t key = ( cx + ( n & 1 ? nx : 0 ) ) * 73856093ull ^ ( cy + ( n & 2 ? ny : 0 ) ) * 19349663ull ^ ( cz + ( n & 4 ? nz : 0 ) ) * 83492791ull;
+				std::unordered_map<uint64_t, uint>::const_iterator cell = cells.find( key );
+
+				// Different cells may share a key, so every candidate is checked
+				for ( uint j = cell != cells.end() ? cell->second : (uint)-1; j != (uint)-1; j = next[j] )
+				{
+					if ( ( positions[j] - p ).LengthSqr() <= tolerance * tolerance ) {
+						weld[i] = j;
+						break;
+					}
+				}
+			}
+
+			if ( weld[i] == i ) {
+				uint64_t key = cx * 73856093ull ^ cy * 19349663ull ^ cz * 83492791ull;
+				std::pair<std::unordered_map<uint64_t, uint>::iterator, bool> res = cells.insert( std::make_pair( key, (uint)i ) );
+				if ( !res.second ) {
+					next[i] = res.first->second;
+					res.first->second = (uint)i;
+				}
+			}
+		}
+	}
+
+	// Corners around a position that share a face normal
+	struct faceGroup
+	{
+		Vec3 normal;
+		float weight;
+		uint first;
+		Vec3 result;
+		bool needed;
+	};
+
+	// Orders vectors by their bits, so equal vectors are next to each other
+	inline bool lessBits( const Vec3& a, const Vec3& b )
+	{
+		uint32_t x[3], y[3];
+		memcpy( x, &a, sizeof( x ) );
+		memcpy( y, &b, sizeof( y ) );
+		return x[0] != y[0] ? x[0] < y[0] : x[1] != y[1] ? x[1] < y[1] : x[2] < y[2];
+	}
+
+	void generateNormals( objData& data, float creaseAngle )
+	{
+		size_t cornerCount = data.corners.size() / 3 * 3;
+		size_t vectorCount = data.vectors.size();
+
+		bool missing = false;
+		for ( size_t i = 0; i < cornerCount && !missing; i++ )
+			missing = data.corners[i].n == 0;
+		if ( !missing ) return;
+
+		std::vector<uint> weld;
+		weldPositions( data.vectors, weld );
+
+		// Unit face normals and corner angles, triangles with invalid positions are skipped
+		std::vector<Vec3> faceNormal( cornerCount / 3 );
+		std::vector<float> angle( cornerCount, 0.0f );
+		std::vector<bool> valid( cornerCount / 3, false );
+
+		for ( size_t t = 0; t < cornerCount / 3; t++ )
+		{
+			const faceVertex* c = &data.corners[t * 3];
+			if ( c[0].v < 1 || c[1].v < 1 || c[2].v < 1 || (size_t)c[0].v > vectorCount || (size_t)c[1].v > vectorCount || (size_t)c[2].v > vectorCount )
 				continue;
+			valid[t] = true;
+
+			// Degenerate triangles don't contribute, but still need normals themselves
+			const Vec3* p[3] = { &data.vectors[c[0].v - 1], &data.vectors[c[1].v - 1], &data.vectors[c[2].v - 1] };
+			Vec3 n = ( *p[1] - *p[0] ).Cross( *p[2] - *p[0] );
+			float length = n.Length();
+			if ( length == 0.0f ) continue;
+			faceNormal[t] = n / length;
+
+			for ( int k = 0; k < 3; k++ )
+			{
+				Vec3 a = *p[(k+1)%3] - *p[k], b = *p[(k+2)%3] - *p[k];
+				float la = a.Length(), lb = b.Length();
+				if ( la > 0.0f && lb > 0.0f ) angle[t*3+k] = acosf( std::min( std::max( a.Dot( b ) / ( la * lb ), -1.0f ), 1.0f ) );
 			}
+		}
+
+		// Corners around every welded position
+		std::vector<uint> offset( vectorCount + 1, 0 );
+		for ( size_t i = 0; i < cornerCount; i++ )
+			if ( valid[i / 3] ) offset[weld[data.corners[i].v - 1] + 1]++;
+		for ( size_t v = 0; v < vectorCount; v++ )
+			offset[v+1] += offset[v];
+
+		std::vector<uint> around( offset[vectorCount] ), fill( offset.begin(), offset.end() - 1 );
+		for ( size_t i = 0; i < cornerCount; i++ )
+			if ( valid[i / 3] ) around[fill[weld[data.corners[i].v - 1]]++] = (uint)i;
+
+		// Corners are bucketed by face normal, so every distinct face normal around a
+		// position is compared with the others once, no matter how many corners have it
+		float minDot = creaseAngle >= 3.14159265f ? -2.0f : cosf( creaseAngle );
+		std::vector<uint> order;
+		std::vector<faceGroup> groups;
+		std::vector<uint> ranked;
+
+		for ( size_t w = 0; w < vectorCount; w++ )
+		{
+			order.assign( around.begin() + offset[w], around.begin() + offset[w+1] );
+			std::sort( order.begin(), order.end(), [&] ( uint x, uint y ) {
+				return lessBits( faceNormal[x / 3], faceNormal[y / 3] );
+			} );
+
+			groups.clear();
+			Vec3 total;
+			for ( size_t a = 0; a < order.size(); a++ )
+			{
+				const Vec3& n = faceNormal[order[a] / 3];
+				if ( a == 0 || lessBits( faceNormal[order[a-1] / 3], n ) ) {
+					faceGroup group = { n, 0.0f, (uint)a, Vec3(), false };
+					groups.push_back( group );
+				}
+				groups.back().weight += angle[order[a]];
+				groups.back().needed = groups.back().needed || data.corners[order[a]].n == 0;
+				total = total + n * angle[order[a]];
+			}
+
+			// Everything is smoothed together if all face normals are within half the
+			// crease angle of their average, so no pair can be further apart
+			bool together = minDot < -1.0f;
+			if ( !together && groups.size() > 2 ) {
+				Vec3 mean = total.Length() > 0.0f ? total / total.Length() : Vec3();
+				float halfDot = cosf( creaseAngle * 0.5f );
+				together = mean.LengthSqr() > 0.0f;
+				for ( size_t g = 0; g < groups.size() && together; g++ )
+					together = groups[g].normal.LengthSqr() == 0.0f || groups[g].normal.Dot( mean ) >= halfDot;
+			}
+
+			for ( size_t g = 0; g < groups.size(); g++ )
+			{
+				if ( !groups[g].needed ) continue;
+
+				// Degenerate triangles take the normal of all faces around them
+				const Vec3& own = groups[g].normal;
+				Vec3 sum = total;
+				if ( !together && own.LengthSqr() > 0.0f ) {
+					sum = Vec3();
+					for ( size_t h = 0; h < groups.size(); h++ )
+						if ( own.Dot( groups[h].normal ) >= minDot ) sum = sum + groups[h].normal * groups[h].weight;
+				}
+
+				float length = sum.Length();
+				groups[g].result = length > 0.0f ? sum / length : own;
+			}
+
+			// Corners that end up with the same normal at a position share it
+			ranked.clear();
+			for ( size_t g = 0; g < groups.size(); g++ )
+				if ( groups[g].needed ) ranked.push_back( (uint)g );
+			std::sort( ranked.begin(), ranked.end(), [&] ( uint x, uint y ) {
+				return lessBits( groups[x].result, groups[y].result ) || ( !lessBits( groups[y].result, groups[x].result ) && x < y );
+			} );
+
+			for ( size_t r = 0; r < ranked.size(); r++ )
+			{
+				faceGroup& group = groups[ranked[r]];
+				if ( r == 0 || lessBits( groups[ranked[r-1]].result, group.result ) ) data.normals.push_back( group.result );
+
+				uint end = ranked[r] + 1 < groups.size() ? groups[ranked[r] + 1].first : (uint)order.size();
+				for ( uint a = group.first; a < end; a++ )
+					if ( data.corners[order[a]].n == 0 ) data.corners[order[a]].n = (int)data.normals.size();
+			}
+		}
+	}
+
+	// Numbers the materials in order of first use and sorts the triangles by
+	// material, the order of the triangles of each material is kept
+	void sortMaterials( objData& data, std::vector<std::string>& names, std::vector<MeshSubmesh>& submeshes )
+	{
+		size_t triCount = data.corners.size() / 3;
+		std::vector<uint> triMaterial( triCount );
+		std::unordered_map<std::string, uint> lookup;
+		static const std::string defaultName;
+
+		const std::string* name = &defaultName;
+		size_t use = 0;
+		uint current = 0;
+		bool changed = true;
 
-			// Find a command
-			if ( mode == MODE_NONE && !IS_SPACING( buf[i] ) ) {
-				if ( buf[i] == 'f' )
-					mode = MODE_FACE;
-				else if ( buf[i] == 'v' ) {
-					if ( IS_SPACING( buf[i+1] ) )
-						mode = MODE_VERTEX;
-					else if ( buf[i+1] == 'n' )
-						mode = MODE_NORMAL;
-					else if ( buf[i+1] == 't' )
-						mode = MODE_TEXTURE;
-					i++;
-				} else
-					mode = MODE_UNKNOWN;
-			} else if ( mode != MODE_NONE ) {
-				switch ( mode )
+		for ( size_t t = 0; t < triCount; t++ )
+		{
+			for ( ; use < data.materialUses.size() && data.materialUses[use].corner <= t * 3; use++ )
+			{
+				name = &data.materialUses[use].name;
+				changed = true;
+			}
+
+			if ( changed ) {
+				std::pair<std::unordered_map<std::string, uint>::iterator, bool> res = lookup.insert( std::make_pair( *name, (uint)names.size() ) );
+				if ( res.second ) names.push_back( *name );
+				current = res.first->second;
+				changed = false;
+			}
+
+			triMaterial[t] = current;
+		}
+
+		// Counting sort
+		std::vector<uint> offsets( names.size() + 1, 0 );
+		for ( size_t t = 0; t < triCount; t++ )
+			offsets[triMaterial[t]+1]++;
+		for ( size_t m = 0; m < names.size(); m++ )
+			offsets[m+1] += offsets[m];
+
+		submeshes.resize( names.size() );
+		for ( size_t m = 0; m < names.size(); m++ )
+		{
+			MeshSubmesh submesh = { (uint)m, offsets[m] * 3, ( offsets[m+1] - offsets[m] ) * 3 };
+			submeshes[m] = submesh;
+		}
+
+		std::vector<faceVertex> sorted( data.corners.size() );
+		for ( size_t t = 0; t < triCount; t++ )
+		{
+			uint dst = offsets[triMaterial[t]]++;
+			std::copy( &data.corners[t * 3], &data.corners[t * 3] + 3, &sorted[dst * 3] );
+		}
+		data.corners.swap( sorted );
+	}
+
+	/*
+		Internal binary mesh format
+
+		The header is followed by the vertex attribute layout and a table of
+		sections, which all start at 64 byte aligned offsets. Unknown sections
+		are skipped when loading.
+
+		Version 2 added the cluster table and cluster index sections, version 3
+		the materials, submeshes and textures. Their strings are stored in one
+		section of zero terminated strings and referred to by offset. Version 4
+		added the tangents section, version 5 the crease angle used for
+		generated normals to the header. Version 6 has the same layout, but
+		tangents are averaged over welded corners and may split vertices.
+	*/
+	const char BINARY_MAGIC[8] = { 'O', 'O', 'G', 'L', 'M', 'S', 'H', 0 };
+	const uint BINARY_VERSION = 6;
+	const uint BINARY_BYTE_ORDER = 0x01020304;
+	const uint64_t BINARY_ALIGNMENT = 64;
+
+	enum binarySectionType
+	{
+		SECTION_VERTICES = 1,
+		SECTION_INDICES = 2,
+		SECTION_CLUSTERS = 3,
+		SECTION_CLUSTER_INDICES = 4,
+		SECTION_STRINGS = 5,
+		SECTION_MATERIALS = 6,
+		SECTION_SUBMESHES = 7,
+		SECTION_TEXTURES = 8,
+		SECTION_TANGENTS = 9
+	};
+
+	enum binaryAttributeType
+	{
+		ATTRIBUTE_POSITION = 1,
+		ATTRIBUTE_TEXCOORD = 2,
+		ATTRIBUTE_NORMAL = 3
+	};
+
+	struct binaryHeader
+	{
+		char magic[8];
+		uint version;
+		uint byteOrder;
+		uint flags;
+		uint attributeCount;
+		uint sectionCount;
+		uint vertexStride;
+		uint64_t sourceSize;
+		uint64_t sourceTime;
+		float creaseAngle;
+		uint reserved;
+	};
+
+	struct binaryAttribute
+	{
+		uint type;
+		uint components;
+		uint dataType;
+		uint offset;
+	};
+
+	struct binarySection
+	{
+		uint type;
+		uint elementSize;
+		uint64_t count;
+		uint64_t offset;
+	};
+
+	struct binaryCluster
+	{
+		uint indexOffset;
+		uint triangleCount;
+		float boundsMin[3], boundsMax[3];
+		float sphereCenter[3], sphereRadius;
+		float coneAxis[3], coneCutoff;
+	};
+
+	struct binaryMaterial
+	{
+		uint name;
+		float ambient[3], diffuse[3], specular[3];
+		float shininess, opacity;
+		int diffuseMap, specularMap, normalMap, alphaMap;
+	};
+
+	struct binarySubmesh
+	{
+		uint material;
+		uint start;
+		uint count;
+	};
+
+	inline uint64_t alignBinary( uint64_t offset )
+	{
+		return ( offset + BINARY_ALIGNMENT - 1 ) / BINARY_ALIGNMENT * BINARY_ALIGNMENT;
+	}
+
+	void writePadding( std::ofstream& file, uint64_t offset )
+	{
+		static const char zeros[BINARY_ALIGNMENT] = {};
+		uint64_t pos = (uint64_t)file.tellp();
+		if ( offset > pos ) file.write( zeros, offset - pos );
+	}
+
+	// Name next to filename that no other thread or process writes to
+	std::string temporaryName( const std::string& filename )
+	{
+		static std::atomic<uint> counter( 0 );
+
+#if defined( OOGL_PLATFORM_WINDOWS )
+		unsigned long process = GetCurrentProcessId();
+#else
+		unsigned long process = (unsigned long)getpid();
+#endif
+
+		std::ostringstream name;
+		name << filename << "." << process << "." << counter++ << ".tmp";
+		return name.str();
+	}
+
+	// Replaces to with from in one step, readers see either the old or the new file
+	bool replaceFile( const std::string& from, const std::string& to )
+	{
+#if defined( OOGL_PLATFORM_WINDOWS )
+		return MoveFileExA( from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING ) != 0;
+#else
+		return rename( from.c_str(), to.c_str() ) == 0;
+#endif
+	}
+
+	bool indicesInRange( const std::vector<uint>& indices, size_t vertexCount )
+	{
+		for ( size_t i = 0; i < indices.size(); i++ )
+			if ( indices[i] >= vertexCount ) return false;
+		return true;
+	}
+
+	bool getFileInfo( const std::string& filename, uint64_t& size, uint64_t& time )
+	{
+		struct stat info;
+		if ( stat( filename.c_str(), &info ) != 0 ) return false;
+
+		size = info.st_size;
+		time = info.st_mtime;
+		return true;
+	}
+
+	void readVertices( const uchar* data, size_t count, uint stride, const binaryAttribute* attributes, uint attributeCount, std::vector<Vertex>& out )
+	{
+		// Files written with the native vertex layout are copied as a whole
+		bool native = stride == sizeof( Vertex ) && attributeCount == 3;
+		for ( uint i = 0; native && i < attributeCount; i++ )
+		{
+			const binaryAttribute& a = attributes[i];
+			native = a.dataType == Type::Float && (
+				( a.type == ATTRIBUTE_POSITION && a.components == 3 && a.offset == offsetof( Vertex, Pos ) ) ||
+				( a.type == ATTRIBUTE_TEXCOORD && a.components == 2 && a.offset == offsetof( Vertex, Tex ) ) ||
+				( a.type == ATTRIBUTE_NORMAL && a.components == 3 && a.offset == offsetof( Vertex, Normal ) ) );
+		}
+
+		if ( native ) {
+			out.assign( (const Vertex*)data, (const Vertex*)data + count );
+			return;
+		}
+
+		// Otherwise gather the known float attributes per vertex
+		out.assign( count, Vertex() );
+
+		for ( uint i = 0; i < attributeCount; i++ )
+		{
+			const binaryAttribute& a = attributes[i];
+			if ( a.dataType != Type::Float || a.offset + a.components * sizeof( float ) > stride ) continue;
+
+			for ( size_t v = 0; v < count; v++ )
+			{
+				float* dst;
+				uint components;
+				if ( a.type == ATTRIBUTE_POSITION ) { dst = &out[v].Pos.X; components = 3; }
+				else if ( a.type == ATTRIBUTE_TEXCOORD ) { dst = &out[v].Tex.X; components = 2; }
+				else if ( a.type == ATTRIBUTE_NORMAL ) { dst = &out[v].Normal.X; components = 3; }
+				else break;
+
+				memcpy( dst, data + v * stride + a.offset, std::min( components, a.components ) * sizeof( float ) );
+			}
+		}
+	}
+
+	Mesh::Mesh()
+	{
+		indexed = optimized = clustered = false;
+		hasTexCoords = hasNormals = hasTangents = false;
+		creaseAngle = 0.0f;
+	}
+
+	Mesh::Mesh( const std::string& filename, MeshOptions::mesh_options_t options, float creaseAngle, uint threads )
+	{
+		this->creaseAngle = creaseAngle;
+		indexed = ( options & MeshOptions::Indexed ) != 0;
+		optimized = indexed && ( options & MeshOptions::Optimize );
+		clustered = ( options & MeshOptions::Clusters ) != 0;
+		hasTangents = ( options & MeshOptions::Tangents ) != 0;
+		hasTexCoords = hasNormals = false;
+
+		// Use the binary cache if it is up to date with the source file
+		uint64_t sourceSize = 0, sourceTime = 0;
+		bool cache = ( options & MeshOptions::Cache ) && getFileInfo( filename, sourceSize, sourceTime );
+		std::string cacheFile = filename + ".cache";
+
+		if ( cache ) {
+			try {
+				if ( ReadBinary( cacheFile, true, sourceSize, sourceTime ) ) return;
+			} catch ( FileException& ) {}
+		}
+
+		Parse( filename, options, threads );
+		// Tangents go first so the vertices they split are optimized too
+		if ( hasTangents ) ComputeTangents();
+		if ( optimized ) Optimize();
+		if ( clustered ) BuildClusters();
+
+		// Failing to write the cache only means the next load has to parse again
+		if ( cache ) {
+			try {
+				WriteBinary( cacheFile, sourceSize, sourceTime );
+			} catch ( FileException& ) {}
+		}
+	}
+
+	void Mesh::SaveBinary( const std::string& filename ) const
+	{
+		WriteBinary( filename, 0, 0 );
+	}
+
+	Mesh Mesh::LoadBinary( const std::string& filename )
+	{
+		Mesh mesh;
+		if ( !mesh.ReadBinary( filename, false, 0, 0 ) ) throw MeshFormatException();
+		return mesh;
+	}
+
+	void Mesh::Parse( const std::string& filename, MeshOptions::mesh_options_t options, uint threads )
+	{
+		// Parse straight from the mapped file
+		MappedFile file( filename );
+		const char* buf = (const char*)file.Data();
+		size_t fileLen = file.Length();
+
+		objData data;
+		if ( options & MeshOptions::Parallel ) {
+			parseParallel( buf, buf + fileLen, data, threads );
+		} else {
+			size_t approxMem = 295 + fileLen / 1024 * 11;
+			data.vectors.reserve( approxMem );
+			data.normals.reserve( approxMem );
+			data.texcoords.reserve( approxMem );
+			data.corners.reserve( approxMem );
+
+			parseChunk( buf, buf + fileLen, data );
+		}
+
+		// Only files that select materials are split into submeshes
+		std::vector<std::string> materialNames;
+		if ( !data.materialUses.empty() ) sortMaterials( data, materialNames, submeshes );
+
+		generateNormals( data, creaseAngle );
+
+		// Assemble vertices from the triangle corners
+		// Indexed meshes usually have about as many vertices as positions
+		std::unordered_map<faceVertex, uint, faceVertexHash> vertexLookup;
+		vertices.reserve( indexed ? data.vectors.size() : data.corners.size() );
+		if ( indexed ) indices.reserve( data.corners.size() );
+
+		for ( size_t i = 0; i < data.corners.size(); i++ )
+		{
+			const faceVertex& corner = data.corners[i];
+			hasTexCoords |= corner.t != 0;
+			hasNormals |= corner.n != 0;
+
+			if ( indexed ) {
+				std::pair<std::unordered_map<faceVertex, uint, faceVertexHash>::iterator, bool> res =
+					vertexLookup.insert( std::make_pair( corner, (uint)vertices.size() ) );
+
+				indices.push_back( res.first->second );
+				if ( !res.second ) continue;
+			}
+
+			vertices.push_back( makeVertex( data, corner ) );
+		}
+
+		// Don't keep the spare capacity from growing past the estimate
+		if ( indexed ) vertices.shrink_to_fit();
+
+		ComputeBounds();
+		if ( !materialNames.empty() ) LoadMaterials( filename, data.libraries, materialNames );
+	}
+
+	void Mesh::ComputeBounds()
+	{
+		bounds = AABB();
+		for ( size_t i = 0; i < vertices.size(); i++ )
+			bounds.Extend( vertices[i].Pos );
+
+		boundingSphere = Sphere::FromPoints( vertices.empty() ? 0 : &vertices[0].Pos, vertices.size(), sizeof( Vertex ) );
+	}
+
+	void Mesh::Stream( const std::string& filename, std::function<void ( const Vertex* vertices, uint count )> sink, uint batchSize )
+	{
+		std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary );
+		if ( !file.is_open() ) throw FileException();
+
+		if ( batchSize == 0 ) batchSize = 1;
+		std::vector<Vertex> batch;
+		batch.reserve( batchSize );
+
+		// The attributes are kept because faces may refer to any earlier one,
+		// the corners are turned into vertices and dropped after every window
+		objData data;
+		std::vector<char> window( STREAM_WINDOW_SIZE );
+		size_t carry = 0;
+
+		while ( true )
+		{
+			file.read( &window[carry], window.size() - carry );
+			size_t length = carry + (size_t)file.gcount();
+			bool eof = length < window.size();
+
+			// Only complete lines are parsed, the rest is moved to the front of the next window
+			const char* buf = &window[0];
+			const char* end = buf + length;
+			if ( !eof ) {
+				while ( end > buf && end[-1] != '\n' ) end--;
+
+				if ( end == buf ) {
+					window.resize( window.size() * 2 );
+					carry = length;
+					continue;
+				}
+			}
+
+			parseChunk( buf, end, data );
+
+			for ( size_t i = 0; i < data.corners.size(); i++ )
+			{
+				batch.push_back( makeVertex( data, data.corners[i] ) );
+
+				if ( batch.size() == batchSize ) {
+					sink( &batch[0], batch.size() );
+					batch.clear();
+				}
+			}
+			data.corners.clear();
+			data.relative.clear();
+			data.materialUses.clear();
+
+			if ( eof ) break;
+
+			carry = buf + length - end;
+			memmove( &window[0], end, carry );
+		}
+
+		if ( !batch.empty() ) sink( &batch[0], batch.size() );
+	}
+
+	bool Mesh::ReadBinary( const std::string& filename, bool checkSource, uint64_t sourceSize, uint64_t sourceTime )
+	{
+		MappedFile file( filename );
+		const uchar* data = file.Data();
+		uint64_t length = file.Length();
+
+		// Validate header
+		binaryHeader header;
+		if ( length < sizeof( header ) ) return false;
+		memcpy( &header, data, sizeof( header ) );
+
+		if ( memcmp( header.magic, BINARY_MAGIC, sizeof( BINARY_MAGIC ) ) != 0 ) return false;
+		if ( header.version != BINARY_VERSION || header.byteOrder != BINARY_BYTE_ORDER ) return false;
+
+		bool fileIndexed = ( header.flags & MeshOptions::Indexed ) != 0;
+		bool fileOptimized = ( header.flags & MeshOptions::Optimize ) != 0;
+		bool fileClustered = ( header.flags & MeshOptions::Clusters ) != 0;
+		bool fileTangents = ( header.flags & MeshOptions::Tangents ) != 0;
+		if ( checkSource && ( header.sourceSize != sourceSize || header.sourceTime != sourceTime || fileIndexed != indexed || fileOptimized != optimized || fileClustered != clustered || fileTangents != hasTangents || header.creaseAngle != creaseAngle ) )
+			return false;
+
+		uint64_t tableEnd = sizeof( header ) + (uint64_t)header.attributeCount * sizeof( binaryAttribute ) + (uint64_t)header.sectionCount * sizeof( binarySection );
+		if ( tableEnd > length ) return false;
+
+		const binaryAttribute* attributes = (const binaryAttribute*)( data + sizeof( header ) );
+		const binarySection* sections = (const binarySection*)( attributes + header.attributeCount );
+
+		// Read sections
+		std::vector<Vertex> newVertices;
+		std::vector<uint> newIndices, newClusterIndices;
+		std::vector<MeshCluster> newClusters;
+		std::vector<MeshSubmesh> newSubmeshes;
+		std::vector<Vec4> newTangents;
+		const binarySection* stringSection = 0;
+		const binarySection* materialSection = 0;
+		const binarySection* textureSection = 0;
+		bool fileTexCoords = false, fileNormals = false;
+
+		for ( uint i = 0; i < header.attributeCount; i++ )
+		{
+			fileTexCoords |= attributes[i].type == ATTRIBUTE_TEXCOORD;
+			fileNormals |= attributes[i].type == ATTRIBUTE_NORMAL;
+		}
+
+		for ( uint i = 0; i < header.sectionCount; i++ )
+		{
+			const binarySection& section = sections[i];
+			if ( section.offset > length || section.elementSize == 0 || section.count > ( length - section.offset ) / section.elementSize )
+				return false;
+
+			const uchar* p = data + section.offset;
+
+			if ( section.type == SECTION_VERTICES ) {
+				if ( section.elementSize != header.vertexStride ) return false;
+				readVertices( p, (size_t)section.count, header.vertexStride, attributes, header.attributeCount, newVertices );
+			} else if ( section.type == SECTION_INDICES || section.type == SECTION_CLUSTER_INDICES ) {
+				std::vector<uint>& out = section.type == SECTION_INDICES ? newIndices : newClusterIndices;
+				if ( section.elementSize == sizeof( ushort ) )
+					out.assign( (const ushort*)p, (const ushort*)p + section.count );
+				else if ( section.elementSize == sizeof( uint ) )
+					out.assign( (const uint*)p, (const uint*)p + section.count );
+				else
+					return false;
+			} else if ( section.type == SECTION_CLUSTERS ) {
+				if ( section.elementSize != sizeof( binaryCluster ) ) return false;
+
+				newClusters.resize( (size_t)section.count );
+				for ( size_t c = 0; c < newClusters.size(); c++ )
+				{
+					binaryCluster bc;
+					memcpy( &bc, p + c * sizeof( bc ), sizeof( bc ) );
+
+					MeshCluster& cluster = newClusters[c];
+					cluster.IndexOffset = bc.indexOffset;
+					cluster.TriangleCount = bc.triangleCount;
+					cluster.Bounds = AABB( Vec3( bc.boundsMin[0], bc.boundsMin[1], bc.boundsMin[2] ), Vec3( bc.boundsMax[0], bc.boundsMax[1], bc.boundsMax[2] ) );
+					cluster.BoundingSphere = Sphere( Vec3( bc.sphereCenter[0], bc.sphereCenter[1], bc.sphereCenter[2] ), bc.sphereRadius );
+					cluster.ConeAxis = Vec3( bc.coneAxis[0], bc.coneAxis[1], bc.coneAxis[2] );
+					cluster.ConeCutoff = bc.coneCutoff;
+				}
+			} else if ( section.type == SECTION_SUBMESHES ) {
+				if ( section.elementSize != sizeof( binarySubmesh ) ) return false;
+
+				newSubmeshes.resize( (size_t)section.count );
+				for ( size_t s = 0; s < newSubmeshes.size(); s++ )
 				{
-				case MODE_UNKNOWN:
-					if ( buf[i] == '\n' )
-						mode = MODE_NONE;
-					break;
-
-				case MODE_VERTEX:
-					i += readVector( &buf[i], v3 );
-					vectors.push_back( v3 );
-					mode = MODE_NONE;
-					break;
-
-				case MODE_NORMAL:
-					i += readVector( &buf[i], v3 );
-					normals.push_back( v3 );
-					mode = MODE_NONE;
-					break;
-
-				case MODE_TEXTURE:
-					i += readVector( &buf[i], v3 );
-					texcoords.push_back( Vec2( v3.X, v3.Y ) );
-					mode = MODE_NONE;
-					break;
-			
-				case MODE_FACE:
-					i += readFace( &buf[i], f );
-					
-					Vertex vertex = {
-						vectors[f.v1 - 1],
-						texcoords[f.t1 - 1],
-						normals[f.n1 - 1]
-					};
-					vertices.push_back( vertex );
-
-					vertex.Pos = vectors[f.v2 - 1];
-					vertex.Tex = texcoords[f.t2 - 1];
-					vertex.Normal = normals[f.n2 - 1];
-					vertices.push_back( vertex );
-
-					vertex.Pos = vectors[f.v3 - 1];
-					vertex.Tex = texcoords[f.t3 - 1];
-					vertex.Normal = normals[f.n3 - 1];
-					vertices.push_back( vertex );
-
-					mode = MODE_NONE;
-					break;
+					binarySubmesh bs;
+					memcpy( &bs, p + s * sizeof( bs ), sizeof( bs ) );
+					MeshSubmesh submesh = { bs.material, bs.start, bs.count };
+					newSubmeshes[s] = submesh;
 				}
+			} else if ( section.type == SECTION_STRINGS ) {
+				stringSection = &section;
+			} else if ( section.type == SECTION_MATERIALS ) {
+				if ( section.elementSize != sizeof( binaryMaterial ) ) return false;
+				materialSection = &section;
+			} else if ( section.type == SECTION_TEXTURES ) {
+				if ( section.elementSize != sizeof( uint ) ) return false;
+				textureSection = &section;
+			} else if ( section.type == SECTION_TANGENTS ) {
+				if ( section.elementSize != sizeof( Vec4 ) ) return false;
+				newTangents.assign( (const Vec4*)p, (const Vec4*)p + section.count );
 			}
 		}
+
+		// Strings are read once all sections are known
+		const char* strings = stringSection ? (const char*)data + stringSection->offset : 0;
+		uint64_t stringsLength = stringSection ? stringSection->count : 0;
+		if ( stringsLength > 0 && strings[stringsLength - 1] != 0 ) return false;
+
+		std::vector<std::string> newTextures( textureSection ? (size_t)textureSection->count : 0 );
+		for ( size_t t = 0; t < newTextures.size(); t++ )
+		{
+			uint offset;
+			memcpy( &offset, data + textureSection->offset + t * sizeof( offset ), sizeof( offset ) );
+			if ( offset >= stringsLength ) return false;
+			newTextures[t] = strings + offset;
+		}
+
+		std::vector<MeshMaterial> newMaterials( materialSection ? (size_t)materialSection->count : 0 );
+		for ( size_t m = 0; m < newMaterials.size(); m++ )
+		{
+			binaryMaterial bm;
+			memcpy( &bm, data + materialSection->offset + m * sizeof( bm ), sizeof( bm ) );
+			if ( bm.name >= stringsLength ) return false;
+
+			MeshMaterial material( strings + bm.name );
+			material.Ambient = Vec3( bm.ambient[0], bm.ambient[1], bm.ambient[2] );
+			material.Diffuse = Vec3( bm.diffuse[0], bm.diffuse[1], bm.diffuse[2] );
+			material.Specular = Vec3( bm.specular[0], bm.specular[1], bm.specular[2] );
+			material.Shininess = bm.shininess;
+			material.Opacity = bm.opacity;
+			material.DiffuseMap = bm.diffuseMap;
+			material.SpecularMap = bm.specularMap;
+			material.NormalMap = bm.normalMap;
+			material.AlphaMap = bm.alphaMap;
+
+			int maps[] = { bm.diffuseMap, bm.specularMap, bm.normalMap, bm.alphaMap };
+			for ( size_t i = 0; i < sizeof( maps ) / sizeof( maps[0] ); i++ )
+				if ( maps[i] < -1 || maps[i] >= (int)newTextures.size() ) return false;
+
+			newMaterials[m] = material;
+		}
+
+		// Submeshes have to refer to existing materials and triangles
+		uint64_t cornerCount = fileIndexed ? newIndices.size() : newVertices.size();
+		for ( size_t s = 0; s < newSubmeshes.size(); s++ )
+		{
+			if ( newSubmeshes[s].Material >= newMaterials.size() || (uint64_t)newSubmeshes[s].Start + newSubmeshes[s].Count > cornerCount )
+				return false;
+		}
+
+		if ( fileTangents != ( newTangents.size() == newVertices.size() ) ) return false;
+
+		// Indices have to refer to existing vertices
+		if ( !indicesInRange( newIndices, newVertices.size() ) || !indicesInRange( newClusterIndices, newVertices.size() ) ) return false;
+
+		// Clusters have to stay within their index array
+		for ( size_t c = 0; c < newClusters.size(); c++ )
+			if ( (uint64_t)newClusters[c].IndexOffset + newClusters[c].TriangleCount * 3ull > newClusterIndices.size() ) return false;
+
+		vertices.swap( newVertices );
+		indices.swap( newIndices );
+		clusters.swap( newClusters );
+		clusterIndices.swap( newClusterIndices );
+		materials.swap( newMaterials );
+		submeshes.swap( newSubmeshes );
+		textures.swap( newTextures );
+		tangents.swap( newTangents );
+		indexed = fileIndexed;
+		optimized = fileOptimized;
+		clustered = fileClustered;
+		hasTexCoords = fileTexCoords;
+		hasNormals = fileNormals;
+		hasTangents = fileTangents;
+		creaseAngle = header.creaseAngle;
+		ComputeBounds();
+
+		return true;
+	}
+
+	void Mesh::WriteBinary( const std::string& filename, uint64_t sourceSize, uint64_t sourceTime ) const
+	{
+		// The file is written under a temporary name and then moved over the
+		// target, so loaders that have the old file mapped never see a partial one
+		std::string tempFile = temporaryName( filename );
+		std::ofstream file( tempFile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+		if ( !file.is_open() ) throw FileException();
+
+		// Vertex layout, attributes that are not present are left out
+		binaryAttribute attributes[3];
+		uint sourceOffsets[3];
+		uint attributeCount = 0, stride = 0;
+
+		binaryAttribute position = { ATTRIBUTE_POSITION, 3, Type::Float, stride };
+		sourceOffsets[attributeCount] = offsetof( Vertex, Pos );
+		attributes[attributeCount++] = position;
+		stride += sizeof( Vec3 );
+
+		if ( hasTexCoords ) {
+			binaryAttribute texcoord = { ATTRIBUTE_TEXCOORD, 2, Type::Float, stride };
+			sourceOffsets[attributeCount] = offsetof( Vertex, Tex );
+			attributes[attributeCount++] = texcoord;
+			stride += sizeof( Vec2 );
+		}
+
+		if ( hasNormals ) {
+			binaryAttribute normal = { ATTRIBUTE_NORMAL, 3, Type::Float, stride };
+			sourceOffsets[attributeCount] = offsetof( Vertex, Normal );
+			attributes[attributeCount++] = normal;
+			stride += sizeof( Vec3 );
+		}
+
+		// Vertices with all attributes are written as they are, others are packed
+		const void* vertexData = vertices.empty() ? 0 : &vertices[0];
+		std::vector<uchar> packedVertices;
+
+		if ( stride != sizeof( Vertex ) ) {
+			packedVertices.resize( vertices.size() * stride );
+			for ( size_t v = 0; v < vertices.size(); v++ )
+				for ( uint i = 0; i < attributeCount; i++ )
+					memcpy( &packedVertices[v * stride + attributes[i].offset], (const uchar*)&vertices[v] + sourceOffsets[i], attributes[i].components * sizeof( float ) );
+			vertexData = packedVertices.empty() ? 0 : &packedVertices[0];
+		}
+
+		// Indices are stored in the smallest type that fits
+		std::vector<ushort> shortIndices, shortClusterIndices;
+		uint indexSize = sizeof( uint );
+		const void* indexData = Indices();
+		const void* clusterIndexData = ClusterIndices();
+
+		if ( IndexType() == Type::UnsignedShort ) {
+			shortIndices.assign( indices.begin(), indices.end() );
+			shortClusterIndices.assign( clusterIndices.begin(), clusterIndices.end() );
+			indexSize = sizeof( ushort );
+			indexData = shortIndices.empty() ? 0 : &shortIndices[0];
+			clusterIndexData = shortClusterIndices.empty() ? 0 : &shortClusterIndices[0];
+		}
+
+		// Cluster table
+		std::vector<binaryCluster> clusterData( clusters.size() );
+		for ( size_t c = 0; c < clusters.size(); c++ )
+		{
+			const MeshCluster& cluster = clusters[c];
+			binaryCluster bc = {
+				cluster.IndexOffset, cluster.TriangleCount,
+				{ cluster.Bounds.Min.X, cluster.Bounds.Min.Y, cluster.Bounds.Min.Z },
+				{ cluster.Bounds.Max.X, cluster.Bounds.Max.Y, cluster.Bounds.Max.Z },
+				{ cluster.BoundingSphere.Center.X, cluster.BoundingSphere.Center.Y, cluster.BoundingSphere.Center.Z },
+				cluster.BoundingSphere.Radius,
+				{ cluster.ConeAxis.X, cluster.ConeAxis.Y, cluster.ConeAxis.Z },
+				cluster.ConeCutoff
+			};
+			clusterData[c] = bc;
+		}
+
+		// Materials, submeshes and textures with their strings
+		std::vector<char> strings;
+		std::vector<binaryMaterial> materialData( materials.size() );
+		std::vector<binarySubmesh> submeshData( submeshes.size() );
+		std::vector<uint> textureData( textures.size() );
+
+		auto addString = [&strings] ( const std::string& str ) -> uint {
+			uint offset = (uint)strings.size();
+			strings.insert( strings.end(), str.c_str(), str.c_str() + str.size() + 1 );
+			return offset;
+		};
+
+		for ( size_t m = 0; m < materials.size(); m++ )
+		{
+			const MeshMaterial& material = materials[m];
+			binaryMaterial bm = {
+				addString( material.Name ),
+				{ material.Ambient.X, material.Ambient.Y, material.Ambient.Z },
+				{ material.Diffuse.X, material.Diffuse.Y, material.Diffuse.Z },
+				{ material.Specular.X, material.Specular.Y, material.Specular.Z },
+				material.Shininess, material.Opacity,
+				material.DiffuseMap, material.SpecularMap, material.NormalMap, material.AlphaMap
+			};
+			materialData[m] = bm;
+		}
+
+		for ( size_t s = 0; s < submeshes.size(); s++ )
+		{
+			binarySubmesh bs = { submeshes[s].Material, submeshes[s].Start, submeshes[s].Count };
+			submeshData[s] = bs;
+		}
+
+		for ( size_t t = 0; t < textures.size(); t++ )
+			textureData[t] = addString( textures[t] );
+
+		// Sections
+		binarySection sections[] = {
+			{ SECTION_VERTICES, stride, vertices.size(), 0 },
+			{ SECTION_INDICES, indexSize, indices.size(), 0 },
+			{ SECTION_CLUSTERS, sizeof( binaryCluster ), clusterData.size(), 0 },
+			{ SECTION_CLUSTER_INDICES, indexSize, clusterIndices.size(), 0 },
+			{ SECTION_STRINGS, 1, strings.size(), 0 },
+			{ SECTION_MATERIALS, sizeof( binaryMaterial ), materialData.size(), 0 },
+			{ SECTION_SUBMESHES, sizeof( binarySubmesh ), submeshData.size(), 0 },
+			{ SECTION_TEXTURES, sizeof( uint ), textureData.size(), 0 },
+			{ SECTION_TANGENTS, sizeof( Vec4 ), tangents.size(), 0 }
+		};
+		const void* sectionData[] = {
+			vertexData, indexData, clusterData.empty() ? 0 : &clusterData[0], clusterIndexData,
+			strings.empty() ? 0 : &strings[0], materialData.empty() ? 0 : &materialData[0],
+			submeshData.empty() ? 0 : &submeshData[0], textureData.empty() ? 0 : &textureData[0],
+			Tangents()
+		};
+		const uint sectionCount = sizeof( sections ) / sizeof( sections[0] );
+
+		uint64_t offset = alignBinary( sizeof( binaryHeader ) + attributeCount * sizeof( binaryAttribute ) + sizeof( sections ) );
+		for ( uint i = 0; i < sectionCount; i++ )
+		{
+			sections[i].offset = offset;
+			offset = alignBinary( offset + sections[i].count * sections[i].elementSize );
+		}
+
+		// Header
+		binaryHeader header;
+		memset( &header, 0, sizeof( header ) );
+		memcpy( header.magic, BINARY_MAGIC, sizeof( BINARY_MAGIC ) );
+		header.version = BINARY_VERSION;
+		header.byteOrder = BINARY_BYTE_ORDER;
+		header.flags = ( indexed ? MeshOptions::Indexed : 0 ) | ( optimized ? MeshOptions::Optimize : 0 ) | ( clustered ? MeshOptions::Clusters : 0 ) | ( hasTangents ? MeshOptions::Tangents : 0 );
+		header.attributeCount = attributeCount;
+		header.sectionCount = sectionCount;
+		header.vertexStride = stride;
+		header.sourceSize = sourceSize;
+		header.sourceTime = sourceTime;
+		header.creaseAngle = creaseAngle;
+
+		// Write file
+		file.write( (const char*)&header, sizeof( header ) );
+		file.write( (const char*)attributes, attributeCount * sizeof( binaryAttribute ) );
+		file.write( (const char*)sections, sizeof( sections ) );
+
+		for ( uint i = 0; i < sectionCount; i++ )
+		{
+			writePadding( file, sections[i].offset );
+			if ( sections[i].count > 0 ) file.write( (const char*)sectionData[i], sections[i].count * sections[i].elementSize );
+		}
+		writePadding( file, offset );
+		file.close();
+
+		if ( !file || !replaceFile( tempFile, filename ) ) {
+			remove( tempFile.c_str() );
+			throw FileException();
+		}
 	}
 
 	const Vertex* Mesh::Vertices() const
@@ -242,4 +1353,44 @@ namespace GL
 	{
 		return vertices.size();
 	}
+
+	const AABB& Mesh::Bounds() const
+	{
+		return bounds;
+	}
+
+	const Sphere& Mesh::BoundingSphere() const
+	{
+		return boundingSphere;
+	}
+
+	bool Mesh::HasTexCoords() const
+	{
+		return hasTexCoords;
+	}
+
+	bool Mesh::HasNormals() const
+	{
+		return hasNormals;
+	}
+
+	bool Mesh::IsIndexed() const
+	{
+		return indexed;
+	}
+
+	const uint* Mesh::Indices() const
+	{
+		return indices.empty() ? 0 : &indices[0];
+	}
+
+	int Mesh::IndexCount() const
+	{
+		return indices.size();
+	}
+
+	Type::type_t Mesh::IndexType() const
+	{
+		return vertices.size() <= 65536 ? Type::UnsignedShort : Type::UnsignedInt;
+	}
 }
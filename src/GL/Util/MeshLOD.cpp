@@ -0,0 +1,457 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/MeshLOD.hpp>
+#include <unordered_map>
+#include <queue>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Internal simplification facilities
+	*/
+
+	// Border edges are kept in place by planes perpendicular to their triangle with this weight
+	const double LOD_BORDER_WEIGHT = 10.0;
+
+	// Sum of squared distances to a set of weighted planes
+	struct quadric
+	{
+		double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2, weight;
+	};
+
+	void addPlane( quadric& q, const Vec3& n, const Vec3& p, double w )
+	{
+		double a = n.X, b = n.Y, c = n.Z, d = -n.Dot( p );
+		q.a2 += w * a * a; q.ab += w * a * b; q.ac += w * a * c; q.ad += w * a * d;
+		q.b2 += w * b * b; q.bc += w * b * c; q.bd += w * b * d;
+		q.c2 += w * c * c; q.cd += w * c * d;
+		q.d2 += w * d * d;
+		q.weight += w;
+	}
+
+	void addQuadric( quadric& q, const quadric& o )
+	{
+		q.a2 += o.a2; q.ab += o.ab; q.ac += o.ac; q.ad += o.ad;
+		q.b2 += o.b2; q.bc += o.bc; q.bd += o.bd;
+		q.c2 += o.c2; q.cd += o.cd;
+		q.d2 += o.d2;
+		q.weight += o.weight;
+	}
+
+	// Root mean square distance of a point to the planes
+	float quadricError( const quadric& q, const quadric& o, const Vec3& p )
+	{
+		quadric s = q;
+		addQuadric( s, o );
+
+		double x = p.X, y = p.Y, z = p.Z;
+		double e = s.a2 * x * x + 2 * s.ab * x * y + 2 * s.ac * x * z + 2 * s.ad * x +
+			s.b2 * y * y + 2 * s.bc * y * z + 2 * s.bd * y +
+			s.c2 * z * z + 2 * s.cd * z + s.d2;
+
+		return s.weight > 0.0 ? (float)sqrt( std::max( e, 0.0 ) / s.weight ) : 0.0f;
+	}
+
+	struct positionKey
+	{
+		float x, y, z;
+
+		bool operator==( const positionKey& o ) const
+		{
+			return x == o.x && y == o.y && z == o.z;
+		}
+	};
+
+	struct positionKeyHash
+	{
+		size_t operator()( const positionKey& k ) const
+		{
+			// -0 equals 0, so it has to hash the same
+			const float v[3] = { k.x == 0.0f ? 0.0f : k.x, k.y == 0.0f ? 0.0f : k.y, k.z == 0.0f ? 0.0f : k.z };
+			uint32_t h[3];
+			memcpy( h, v, sizeof( h ) );
+			return ( (size_t)h[0] * 73856093 ) ^ ( (size_t)h[1] * 19349663 ) ^ ( (size_t)h[2] * 83492791 );
+		}
+	};
+
+	struct edgeCollapse
+	{
+		float error;
+		uint from, to;
+		uint fromVersion, toVersion;
+
+		bool operator>( const edgeCollapse& o ) const
+		{
+			return error > o.error;
+		}
+	};
+
+	/*
+		Vertices with the same position form one simplification vertex, so
+		seams in the texture coordinates or normals don't tear apart. When such
+		a vertex is collapsed, each of its attribute vertices is replaced by the
+		one it shares an edge with at the destination, or the most similar one.
+	*/
+	struct simplifier
+	{
+		const Vertex* vertices;
+		std::vector<uint> tris;
+		std::vector<bool> alive;
+		uint aliveCount;
+		float error;
+
+		std::vector<uint> group;
+		std::vector<Vec3> groupPos;
+		std::vector<std::vector<uint>> groupTris, groupVertices;
+		std::vector<quadric> quadrics;
+		std::vector<uint> version;
+		std::vector<bool> removed;
+		std::vector<uint> neighbours;
+
+		std::priority_queue<edgeCollapse, std::vector<edgeCollapse>, std::greater<edgeCollapse>> queue;
+
+		void Init( const Mesh& mesh );
+		void PushEdges( uint g, bool initial );
+		bool Flips( uint from, uint to ) const;
+		uint Partner( uint v, uint to, std::vector<std::pair<uint, uint>>& partners ) const;
+		void Collapse( uint from, uint to, float error );
+		void Run( uint target );
+	};
+
+	void simplifier::Init( const Mesh& mesh )
+	{
+		vertices = mesh.Vertices();
+		uint vertexCount = mesh.VertexCount();
+
+		if ( mesh.IsIndexed() ) {
+			tris.assign( mesh.Indices(), mesh.Indices() + mesh.IndexCount() );
+		} else {
+			tris.resize( vertexCount );
+			for ( uint i = 0; i < vertexCount; i++ ) tris[i] = i;
+		}
+
+		uint triCount = tris.size() / 3;
+		alive.assign( triCount, true );
+		aliveCount = triCount;
+		error = 0.0f;
+
+		// Group vertices by position
+		std::unordered_map<positionKey, uint, positionKeyHash> groups;
+		group.resize( vertexCount );
+
+		for ( uint v = 0; v < vertexCount; v++ )
+		{
+			const Vec3& p = vertices[v].Pos;
+			positionKey key = { p.X, p.Y, p.Z };
+			std::pair<std::unordered_map<positionKey, uint, positionKeyHash>::iterator, bool> res = groups.insert( std::make_pair( key, (uint)groupPos.size() ) );
+			if ( res.second ) groupPos.push_back( p );
+			group[v] = res.first->second;
+		}
+
+		uint groupCount = groupPos.size();
+		groupTris.resize( groupCount );
+		groupVertices.resize( groupCount );
+		quadrics.assign( groupCount, quadric() );
+		version.assign( groupCount, 0 );
+		removed.assign( groupCount, false );
+
+		for ( uint v = 0; v < vertexCount; v++ )
+			groupVertices[group[v]].push_back( v );
+
+		// Every triangle adds its plane weighted by area to its corners
+		std::unordered_map<uint64_t, uint> edgeUse;
+
+		for ( uint t = 0; t < triCount; t++ )
+		{
+			const Vec3& p0 = groupPos[group[tris[t*3]]];
+			Vec3 n = ( groupPos[group[tris[t*3+1]]] - p0 ).Cross( groupPos[group[tris[t*3+2]]] - p0 );
+			float area = n.Length();
+			if ( area > 0.0f ) n = n / area;
+
+			for ( int i = 0; i < 3; i++ )
+			{
+				uint a = group[tris[t*3+i]], b = group[tris[t*3+(i+1)%3]];
+				addPlane( quadrics[a], n, p0, area * 0.5 );
+				groupTris[a].push_back( t );
+
+				uint64_t key = ( (uint64_t)std::min( a, b ) << 32 ) | std::max( a, b );
+				edgeUse[key]++;
+			}
+		}
+
+		// Edges with a single triangle are borders that should stay in place
+		for ( uint t = 0; t < triCount; t++ )
+		{
+			const Vec3& p0 = groupPos[group[tris[t*3]]];
+			Vec3 n = ( groupPos[group[tris[t*3+1]]] - p0 ).Cross( groupPos[group[tris[t*3+2]]] - p0 );
+
+			for ( int i = 0; i < 3; i++ )
+			{
+				uint a = group[tris[t*3+i]], b = group[tris[t*3+(i+1)%3]];
+				uint64_t key = ( (uint64_t)std::min( a, b ) << 32 ) | std::max( a, b );
+				if ( a == b || edgeUse[key] != 1 ) continue;
+
+				Vec3 edge = groupPos[b] - groupPos[a];
+				Vec3 perp = edge.Cross( n );
+				float length = perp.Length();
+				if ( length == 0.0f ) continue;
+
+				double weight = LOD_BORDER_WEIGHT * edge.LengthSqr();
+				addPlane( quadrics[a], perp / length, groupPos[a], weight );
+				addPlane( quadrics[b], perp / length, groupPos[a], weight );
+			}
+		}
+
+		for ( uint g = 0; g < groupCount; g++ )
+			PushEdges( g, true );
+	}
+
+	void simplifier::PushEdges( uint g, bool initial )
+	{
+		const std::vector<uint>& list = groupTris[g];
+
+		neighbours.clear();
+		for ( size_t i = 0; i < list.size(); i++ )
+		{
+			for ( int k = 0; k < 3; k++ )
+			{
+				// Initially every edge is visited from both ends, so take it once
+				uint o = group[tris[list[i]*3+k]];
+				if ( o != g && ( !initial || o > g ) ) neighbours.push_back( o );
+			}
+		}
+
+		std::sort( neighbours.begin(), neighbours.end() );
+		neighbours.erase( std::unique( neighbours.begin(), neighbours.end() ), neighbours.end() );
+
+		for ( size_t i = 0; i < neighbours.size(); i++ )
+		{
+			uint o = neighbours[i];
+			edgeCollapse there = { quadricError( quadrics[g], quadrics[o], groupPos[o] ), g, o, version[g], version[o] };
+			edgeCollapse back = { quadricError( quadrics[g], quadrics[o], groupPos[g] ), o, g, version[o], version[g] };
+			queue.push( there );
+			queue.push( back );
+		}
+	}
+
+	bool simplifier::Flips( uint from, uint to ) const
+	{
+		const std::vector<uint>& list = groupTris[from];
+
+		for ( size_t i = 0; i < list.size(); i++ )
+		{
+			uint t = list[i];
+			if ( !alive[t] ) continue;
+
+			Vec3 p[3], q[3];
+			bool shared = false;
+
+			for ( int k = 0; k < 3; k++ )
+			{
+				uint g = group[tris[t*3+k]];
+				shared |= g == to;
+				p[k] = groupPos[g];
+				q[k] = g == from ? groupPos[to] : p[k];
+			}
+			if ( shared ) continue;
+
+			Vec3 before = ( p[1] - p[0] ).Cross( p[2] - p[0] );
+			Vec3 after = ( q[1] - q[0] ).Cross( q[2] - q[0] );
+			if ( before.LengthSqr() > 0.0f && before.Dot( after ) <= 0.0f ) return true;
+		}
+
+		return false;
+	}
+
+	uint simplifier::Partner( uint v, uint to, std::vector<std::pair<uint, uint>>& partners ) const
+	{
+		for ( size_t i = 0; i < partners.size(); i++ )
+			if ( partners[i].first == v ) return partners[i].second;
+
+		// Use the attribute vertex at the destination that looks most alike
+		const std::vector<uint>& candidates = groupVertices[to];
+		uint best = candidates[0];
+		float bestDist = -1.0f;
+
+		for ( size_t i = 0; i < candidates.size(); i++ )
+		{
+			const Vertex& a = vertices[v];
+			const Vertex& b = vertices[candidates[i]];
+			float dist = ( a.Normal - b.Normal ).LengthSqr() + ( a.Tex - b.Tex ).LengthSqr();
+			if ( bestDist < 0.0f || dist < bestDist ) {
+				bestDist = dist;
+				best = candidates[i];
+			}
+		}
+
+		partners.push_back( std::make_pair( v, best ) );
+		return best;
+	}
+
+	void simplifier::Collapse( uint from, uint to, float collapseError )
+	{
+		std::vector<uint>& list = groupTris[from];
+		std::vector<uint>& dest = groupTris[to];
+
+		// Attribute vertices that share an edge with the destination move along that edge
+		std::vector<std::pair<uint, uint>> partners;
+		for ( size_t i = 0; i < list.size(); i++ )
+		{
+			uint t = list[i];
+			if ( !alive[t] ) continue;
+
+			int shared = -1;
+			for ( int k = 0; k < 3; k++ )
+				if ( group[tris[t*3+k]] == to ) shared = k;
+			if ( shared < 0 ) continue;
+
+			for ( int k = 0; k < 3; k++ )
+				if ( group[tris[t*3+k]] == from ) partners.push_back( std::make_pair( tris[t*3+k], tris[t*3+shared] ) );
+		}
+
+		// Triangles on the edge disappear, the others are moved over
+		for ( size_t i = 0; i < list.size(); i++ )
+		{
+			uint t = list[i];
+			if ( !alive[t] ) continue;
+
+			bool shared = false;
+			for ( int k = 0; k < 3; k++ )
+				shared |= group[tris[t*3+k]] == to;
+
+			if ( shared ) {
+				alive[t] = false;
+				aliveCount--;
+				continue;
+			}
+
+			for ( int k = 0; k < 3; k++ )
+				if ( group[tris[t*3+k]] == from ) tris[t*3+k] = Partner( tris[t*3+k], to, partners );
+
+			dest.push_back( t );
+		}
+
+		list.clear();
+		dest.erase( std::remove_if( dest.begin(), dest.end(), [this] ( uint t ) { return !alive[t]; } ), dest.end() );
+		std::sort( dest.begin(), dest.end() );
+		dest.erase( std::unique( dest.begin(), dest.end() ), dest.end() );
+
+		addQuadric( quadrics[to], quadrics[from] );
+		removed[from] = true;
+		version[to]++;
+		error = std::max( error, collapseError );
+
+		PushEdges( to, false );
+	}
+
+	void simplifier::Run( uint target )
+	{
+		while ( aliveCount > target && !queue.empty() )
+		{
+			edgeCollapse c = queue.top();
+			queue.pop();
+
+			if ( removed[c.from] || removed[c.to] || version[c.from] != c.fromVersion || version[c.to] != c.toVersion ) continue;
+			if ( Flips( c.from, c.to ) ) continue;
+
+			Collapse( c.from, c.to, c.error );
+		}
+	}
+
+	MeshLOD::MeshLOD( const Mesh& mesh, int levels, float ratio )
+	{
+		std::vector<float> ratios( std::max( levels - 1, 0 ) );
+		float r = 1.0f;
+		for ( size_t i = 0; i < ratios.size(); i++ )
+			ratios[i] = r *= ratio;
+
+		Build( mesh, ratios.empty() ? 0 : &ratios[0], ratios.size() );
+	}
+
+	MeshLOD::MeshLOD( const Mesh& mesh, const float ratios[], int count )
+	{
+		Build( mesh, ratios, count );
+	}
+
+	void MeshLOD::Build( const Mesh& mesh, const float ratios[], int count )
+	{
+		simplifier s;
+		s.Init( mesh );
+
+		level original = { s.tris, 0.0f };
+		levels.push_back( original );
+
+		uint triCount = s.tris.size() / 3;
+
+		for ( int i = 0; i < count; i++ )
+		{
+			s.Run( (uint)( triCount * ratios[i] ) );
+
+			level l;
+			l.error = s.error;
+			l.indices.reserve( s.aliveCount * 3 );
+			for ( uint t = 0; t < triCount; t++ )
+				if ( s.alive[t] ) l.indices.insert( l.indices.end(), &s.tris[t*3], &s.tris[t*3] + 3 );
+
+			levels.push_back( l );
+		}
+	}
+
+	int MeshLOD::LevelCount() const
+	{
+		return levels.size();
+	}
+
+	const uint* MeshLOD::Indices( int level ) const
+	{
+		return levels[level].indices.empty() ? 0 : &levels[level].indices[0];
+	}
+
+	int MeshLOD::IndexCount( int level ) const
+	{
+		return levels[level].indices.size();
+	}
+
+	float MeshLOD::Error( int level ) const
+	{
+		return levels[level].error;
+	}
+
+	int MeshLOD::SelectLevel( const Mat4& proj, float distance, float viewportHeight, float maxPixelError ) const
+	{
+		// Pixels per unit at the distance, the clip space w of a point at z = -distance
+		float w = proj.m[15] - proj.m[11] * distance;
+		if ( w <= 0.0f ) return levels.size() - 1;
+
+		float pixelsPerUnit = proj.m[5] * viewportHeight * 0.5f / w;
+
+		// The errors only grow with every level
+		for ( int i = levels.size() - 1; i > 0; i-- )
+			if ( levels[i].error * pixelsPerUnit <= maxPixelError ) return i;
+
+		return 0;
+	}
+}
\ No newline at end of file
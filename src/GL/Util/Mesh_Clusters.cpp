@@ -0,0 +1,257 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/Mesh.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Clusters are grown greedily from a seed triangle by adding the
+		neighbouring triangle that introduces the fewest new vertices, with
+		ties broken by the distance to the centre of the cluster. The next
+		cluster is seeded next to the previous one to keep them compact.
+		Only triangles of the same submesh are added to a cluster.
+
+		Triangles are neighbours when they share a vertex position, so that
+		seams and non-indexed meshes don't split up the clusters.
+	*/
+	inline Vec3 triangleCenter( const Vertex* vertices, const uint* tri )
+	{
+		return ( vertices[tri[0]].Pos + vertices[tri[1]].Pos + vertices[tri[2]].Pos ) / 3.0f;
+	}
+
+	void computeCluster( MeshCluster& cluster, const Vertex* vertices, const uint* indices, std::vector<Vec3>& points )
+	{
+		// Bounds
+		points.clear();
+		cluster.Bounds = AABB();
+
+		for ( uint i = 0; i < cluster.TriangleCount * 3; i++ )
+		{
+			const Vec3& p = vertices[indices[cluster.IndexOffset + i]].Pos;
+			cluster.Bounds.Extend( p );
+			points.push_back( p );
+		}
+
+		cluster.BoundingSphere = Sphere::FromPoints( &points[0], points.size() );
+
+		// The cone axis is the average normal, its cutoff the sine of the
+		// angle between the axis and the normal that deviates the most
+		std::vector<Vec3>& normals = points;
+		normals.clear();
+		Vec3 axis;
+
+		for ( uint t = 0; t < cluster.TriangleCount; t++ )
+		{
+			const uint* tri = indices + cluster.IndexOffset + t * 3;
+			const Vec3& p0 = vertices[tri[0]].Pos;
+			Vec3 n = ( vertices[tri[1]].Pos - p0 ).Cross( vertices[tri[2]].Pos - p0 );
+
+			float length = n.Length();
+			if ( length == 0.0f ) continue;
+
+			normals.push_back( n / length );
+			axis = axis + normals.back();
+		}
+
+		float axisLength = axis.Length();
+		cluster.ConeAxis = axisLength > 0.0f ? axis / axisLength : Vec3();
+		cluster.ConeCutoff = 1.0f;
+		if ( axisLength == 0.0f ) return;
+
+		float minDot = 1.0f;
+		for ( size_t i = 0; i < normals.size(); i++ )
+			minDot = std::min( minDot, normals[i].Dot( cluster.ConeAxis ) );
+
+		// Cones that are wider than a hemisphere can never be culled
+		if ( minDot > 0.0f ) cluster.ConeCutoff = sqrtf( 1.0f - minDot * minDot );
+	}
+
+	bool MeshCluster::IsBackfacing( const Vec3& viewer ) const
+	{
+		Vec3 d = BoundingSphere.Center - viewer;
+		return d.Dot( ConeAxis ) > ConeCutoff * d.Length() + BoundingSphere.Radius;
+	}
+
+	void Mesh::BuildClusters( uint maxVertices, uint maxTriangles )
+	{
+		maxVertices = std::max( maxVertices, 3u );
+		maxTriangles = std::max( maxTriangles, 1u );
+
+		// Non-indexed meshes are clustered as if every vertex was indexed once
+		std::vector<uint> sequential;
+		if ( !indexed ) {
+			sequential.resize( vertices.size() );
+			for ( size_t i = 0; i < sequential.size(); i++ )
+				sequential[i] = (uint)i;
+		}
+
+		const std::vector<uint>& source = indexed ? indices : sequential;
+		size_t triCount = source.size() / 3;
+		size_t vertexCount = vertices.size();
+
+		// Vertices with the same position are represented by the first of them
+		std::vector<uint> order( vertexCount ), position( vertexCount );
+		for ( size_t v = 0; v < vertexCount; v++ )
+			order[v] = (uint)v;
+
+		auto less = [this] ( uint a, uint b ) {
+			const Vec3& pa = vertices[a].Pos;
+			const Vec3& pb = vertices[b].Pos;
+			return pa.X < pb.X || ( pa.X == pb.X && ( pa.Y < pb.Y || ( pa.Y == pb.Y && pa.Z < pb.Z ) ) );
+		};
+		std::sort( order.begin(), order.end(), less );
+
+		for ( size_t i = 0; i < vertexCount; i++ )
+		{
+			bool same = i > 0 && !less( order[i-1], order[i] );
+			position[order[i]] = same ? position[order[i-1]] : order[i];
+		}
+
+		// Triangles using each position
+		std::vector<uint> adjacencyOffset( vertexCount + 1, 0 );
+		for ( size_t i = 0; i < triCount * 3; i++ )
+			adjacencyOffset[position[source[i]]+1]++;
+		for ( size_t v = 0; v < vertexCount; v++ )
+			adjacencyOffset[v+1] += adjacencyOffset[v];
+
+		std::vector<uint> adjacency( triCount * 3 ), fill( adjacencyOffset.begin(), adjacencyOffset.end() - 1 );
+		for ( size_t i = 0; i < triCount * 3; i++ )
+			adjacency[fill[position[source[i]]]++] = (uint)( i / 3 );
+
+		// Submesh of every triangle
+		std::vector<uint> submesh( triCount, 0 );
+		for ( size_t i = 0; i < submeshes.size(); i++ )
+			std::fill( submesh.begin() + submeshes[i].Start / 3, submesh.begin() + ( submeshes[i].Start + submeshes[i].Count ) / 3, (uint)i );
+
+		// The vertices of the current cluster are marked with its number
+		std::vector<uint> mark( vertexCount, (uint)-1 );
+		std::vector<bool> used( triCount, false );
+		std::vector<uint> candidates;
+		std::vector<Vec3> points;
+
+		clusters.clear();
+		clusterIndices.clear();
+		clusterIndices.reserve( triCount * 3 );
+
+		size_t nextSeed = 0;
+
+		while ( true )
+		{
+			// Seed next to the previous cluster, or otherwise at the first unused triangle
+			size_t tri = triCount;
+			for ( size_t i = 0; i < candidates.size() && tri == triCount; i++ )
+				if ( !used[candidates[i]] ) tri = candidates[i];
+
+			while ( tri == triCount && nextSeed < triCount )
+				if ( !used[nextSeed++] ) tri = nextSeed - 1;
+			if ( tri == triCount ) break;
+
+			uint id = (uint)clusters.size();
+			MeshCluster cluster;
+			cluster.IndexOffset = (uint)clusterIndices.size();
+			cluster.TriangleCount = 0;
+
+			uint vertexTotal = 0, group = submesh[tri];
+			Vec3 centerSum;
+			candidates.clear();
+
+			while ( true )
+			{
+				const uint* corners = &source[tri * 3];
+				used[tri] = true;
+				clusterIndices.insert( clusterIndices.end(), corners, corners + 3 );
+				cluster.TriangleCount++;
+				centerSum = centerSum + triangleCenter( &vertices[0], corners );
+
+				for ( int k = 0; k < 3; k++ )
+				{
+					uint v = corners[k], p = position[v];
+					if ( mark[v] == id ) continue;
+
+					mark[v] = id;
+					vertexTotal++;
+					for ( uint a = adjacencyOffset[p]; a < adjacencyOffset[p+1]; a++ )
+						if ( !used[adjacency[a]] && submesh[adjacency[a]] == group ) candidates.push_back( adjacency[a] );
+				}
+
+				if ( cluster.TriangleCount == maxTriangles ) break;
+
+				// Pick the best neighbour that still fits and drop the used ones
+				Vec3 center = centerSum / (float)cluster.TriangleCount;
+				size_t best = triCount;
+				uint bestNew = 4;
+				float bestDist = 0.0f;
+				size_t kept = 0;
+
+				for ( size_t i = 0; i < candidates.size(); i++ )
+				{
+					uint c = candidates[i];
+					if ( used[c] ) continue;
+					candidates[kept++] = c;
+
+					const uint* cc = &source[c * 3];
+					uint added = ( mark[cc[0]] != id ) + ( mark[cc[1]] != id ) + ( mark[cc[2]] != id );
+					if ( vertexTotal + added > maxVertices || added > bestNew ) continue;
+
+					float dist = ( triangleCenter( &vertices[0], cc ) - center ).LengthSqr();
+					if ( added < bestNew || dist < bestDist ) {
+						best = c;
+						bestNew = added;
+						bestDist = dist;
+					}
+				}
+				candidates.resize( kept );
+
+				if ( best == triCount ) break;
+				tri = best;
+			}
+
+			computeCluster( cluster, &vertices[0], &clusterIndices[0], points );
+			clusters.push_back( cluster );
+		}
+
+		clustered = true;
+	}
+
+	const MeshCluster* Mesh::Clusters() const
+	{
+		return clusters.empty() ? 0 : &clusters[0];
+	}
+
+	int Mesh::ClusterCount() const
+	{
+		return clusters.size();
+	}
+
+	const uint* Mesh::ClusterIndices() const
+	{
+		return clusterIndices.empty() ? 0 : &clusterIndices[0];
+	}
+
+	int Mesh::ClusterIndexCount() const
+	{
+		return clusterIndices.size();
+	}
+}
\ No newline at end of file
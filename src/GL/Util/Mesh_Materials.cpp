@@ -0,0 +1,240 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/Mesh.hpp>
+#include <fstream>
+#include <sstream>
+#include <locale>
+#include <unordered_map>
+#include <algorithm>
+
+namespace GL
+{
+	/*
+		Internal MTL parsing facilities
+	*/
+	std::string directoryOf( const std::string& filename )
+	{
+		size_t slash = filename.find_last_of( "/\\" );
+		return slash == std::string::npos ? "" : filename.substr( 0, slash + 1 );
+	}
+
+	void trimRight( std::string& str )
+	{
+		size_t end = str.find_last_not_of( " \t\r" );
+		str.erase( end == std::string::npos ? 0 : end + 1 );
+	}
+
+	// Paths are relative to the file that refers to them, with forward slashes
+	std::string resolvePath( const std::string& directory, std::string path )
+	{
+		std::replace( path.begin(), path.end(), '\\', '/' );
+		while ( path.compare( 0, 2, "./" ) == 0 ) path.erase( 0, 2 );
+
+		bool absolute = ( !path.empty() && path[0] == '/' ) || ( path.size() > 1 && path[1] == ':' );
+		return absolute ? path : directory + path;
+	}
+
+	bool isNumber( const std::string& token )
+	{
+		std::istringstream stream( token );
+		stream.imbue( std::locale::classic() );
+		float number;
+		return stream >> number && ( stream >> std::ws ).eof();
+	}
+
+	// Map statements may have options before the file name, like -bm 0.5 or -o 0 0.5
+	std::string readMapPath( const std::string& text )
+	{
+		size_t pos = 0;
+
+		while ( true )
+		{
+			pos = text.find_first_not_of( " \t\r", pos );
+			if ( pos == std::string::npos ) return "";
+
+			size_t end = std::min( text.find_first_of( " \t\r", pos ), text.size() );
+			std::string token = text.substr( pos, end - pos );
+
+			// Options take 1 argument, except for -mm with 2 and -o, -s and -t with up to 3
+			int args = 0, optional = 0;
+			if ( token == "-mm" ) args = 2;
+			else if ( token == "-o" || token == "-s" || token == "-t" ) args = 1, optional = 2;
+			else if ( token[0] == '-' && token.size() > 1 ) args = 1;
+			else break;
+
+			pos = end;
+			for ( int i = 0; i < args + optional; i++ )
+			{
+				size_t start = text.find_first_not_of( " \t\r", pos );
+				if ( start == std::string::npos ) return "";
+
+				size_t stop = std::min( text.find_first_of( " \t\r", start ), text.size() );
+				if ( i >= args && !isNumber( text.substr( start, stop - start ) ) ) break;
+				pos = stop;
+			}
+		}
+
+		std::string path = text.substr( pos );
+		trimRight( path );
+		return path;
+	}
+
+	// Colors are r, g and b where missing components equal r, the spectral and
+	// xyz forms are not supported and leave the color as it was
+	void readColor( std::istringstream& line, Vec3& color )
+	{
+		float r, g, b;
+		if ( !( line >> r ) ) return;
+		if ( !( line >> g ) ) g = r;
+		if ( !( line >> b ) ) b = r;
+		color = Vec3( r, g, b );
+	}
+
+	struct mtlData
+	{
+		std::vector<MeshMaterial> materials;
+		std::vector<std::string> maps;
+	};
+
+	MeshMaterial::MeshMaterial( const std::string& name )
+		: Name( name ), Diffuse( 1, 1, 1 ), Shininess( 0.0f ), Opacity( 1.0f ), DiffuseMap( -1 ), SpecularMap( -1 ), NormalMap( -1 ), AlphaMap( -1 )
+	{
+	}
+
+	// Texture maps are stored as -2 - index into the list of map paths until they are resolved
+	void parseMaterialLibrary( const std::string& filename, mtlData& out )
+	{
+		std::ifstream file( filename.c_str() );
+		if ( !file.is_open() ) return;
+
+		MeshMaterial* material = 0;
+		std::string text, command;
+
+		while ( std::getline( file, text ) )
+		{
+			std::istringstream line( text );
+			line.imbue( std::locale::classic() );
+			if ( !( line >> command ) ) continue;
+
+			if ( command == "newmtl" ) {
+				std::string name;
+				std::getline( line >> std::ws, name );
+				trimRight( name );
+
+				out.materials.push_back( MeshMaterial( name ) );
+				material = &out.materials.back();
+				continue;
+			}
+
+			// Statements before the first material are ignored
+			if ( !material ) continue;
+
+			int* map = 0;
+			if ( command == "Ka" ) readColor( line, material->Ambient );
+			else if ( command == "Kd" ) readColor( line, material->Diffuse );
+			else if ( command == "Ks" ) readColor( line, material->Specular );
+			else if ( command == "Ns" ) line >> material->Shininess;
+			else if ( command == "d" ) line >> material->Opacity;
+			else if ( command == "Tr" && line >> material->Opacity ) material->Opacity = 1.0f - material->Opacity;
+			else if ( command == "map_Kd" ) map = &material->DiffuseMap;
+			else if ( command == "map_Ks" ) map = &material->SpecularMap;
+			else if ( command == "map_Bump" || command == "map_bump" || command == "bump" || command == "norm" ) map = &material->NormalMap;
+			else if ( command == "map_d" ) map = &material->AlphaMap;
+
+			if ( map ) {
+				std::string rest;
+				std::getline( line, rest );
+				std::string path = readMapPath( rest );
+				if ( path.empty() ) continue;
+
+				*map = -2 - (int)out.maps.size();
+				out.maps.push_back( resolvePath( directoryOf( filename ), path ) );
+			}
+		}
+	}
+
+	void Mesh::LoadMaterials( const std::string& filename, const std::vector<std::string>& libraries, const std::vector<std::string>& names )
+	{
+		// Missing libraries are skipped, their materials get the defaults
+		mtlData data;
+		std::string directory = directoryOf( filename );
+		for ( size_t i = 0; i < libraries.size(); i++ )
+			parseMaterialLibrary( resolvePath( directory, libraries[i] ), data );
+
+		// Later definitions of a material replace earlier ones
+		std::unordered_map<std::string, size_t> lookup;
+		for ( size_t i = 0; i < data.materials.size(); i++ )
+			lookup[data.materials[i].Name] = i;
+
+		std::unordered_map<std::string, int> textureLookup;
+		materials.resize( names.size() );
+		textures.clear();
+
+		for ( size_t i = 0; i < names.size(); i++ )
+		{
+			std::unordered_map<std::string, size_t>::const_iterator it = lookup.find( names[i] );
+			materials[i] = it != lookup.end() ? data.materials[it->second] : MeshMaterial( names[i] );
+
+			// Every texture file is listed once, no matter how many materials use it
+			int* maps[] = { &materials[i].DiffuseMap, &materials[i].SpecularMap, &materials[i].NormalMap, &materials[i].AlphaMap };
+			for ( size_t m = 0; m < sizeof( maps ) / sizeof( maps[0] ); m++ )
+			{
+				if ( *maps[m] == -1 ) continue;
+
+				const std::string& path = data.maps[-2 - *maps[m]];
+				std::pair<std::unordered_map<std::string, int>::iterator, bool> res = textureLookup.insert( std::make_pair( path, (int)textures.size() ) );
+				if ( res.second ) textures.push_back( path );
+				*maps[m] = res.first->second;
+			}
+		}
+	}
+
+	const MeshMaterial* Mesh::Materials() const
+	{
+		return materials.empty() ? 0 : &materials[0];
+	}
+
+	int Mesh::MaterialCount() const
+	{
+		return materials.size();
+	}
+
+	const MeshSubmesh* Mesh::Submeshes() const
+	{
+		return submeshes.empty() ? 0 : &submeshes[0];
+	}
+
+	int Mesh::SubmeshCount() const
+	{
+		return submeshes.size();
+	}
+
+	const std::string& Mesh::Texture( int index ) const
+	{
+		return textures[index];
+	}
+
+	int Mesh::TextureCount() const
+	{
+		return textures.size();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,261 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/Mesh.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Vertex cache optimization as described by Tom Forsyth in "Linear-Speed
+		Vertex Cache Optimisation": every vertex is scored by its position in a
+		simulated LRU cache and by the amount of triangles still using it, and
+		the triangle with the highest total score is emitted next
+	*/
+	const int OPTIMIZE_CACHE_SIZE = 32;
+	const int OPTIMIZE_MAX_VALENCE = 32;
+
+	struct optimizeTables
+	{
+		float cache[OPTIMIZE_CACHE_SIZE];
+		float valence[OPTIMIZE_MAX_VALENCE];
+
+		optimizeTables()
+		{
+			// The last triangle is rendered with its vertices at the front of the
+			// cache, so those get a fixed score to not favour any particular order
+			for ( int i = 0; i < OPTIMIZE_CACHE_SIZE; i++ )
+				cache[i] = i < 3 ? 0.75f : powf( 1.0f - ( i - 3 ) / float( OPTIMIZE_CACHE_SIZE - 3 ), 1.5f );
+
+			// Vertices with few triangles left are boosted to get rid of them
+			for ( int i = 0; i < OPTIMIZE_MAX_VALENCE; i++ )
+				valence[i] = i == 0 ? 0.0f : 2.0f / sqrtf( (float)i );
+		}
+	};
+
+	inline float vertexScore( const optimizeTables& tables, int cachePos, uint remaining )
+	{
+		if ( remaining == 0 ) return -1.0f;
+
+		float score = cachePos >= 0 ? tables.cache[cachePos] : 0.0f;
+		return score + ( remaining < (uint)OPTIMIZE_MAX_VALENCE ? tables.valence[remaining] : 2.0f / sqrtf( (float)remaining ) );
+	}
+
+	void optimizeTriangles( std::vector<uint>& indices, size_t vertexCount )
+	{
+		static const optimizeTables tables;
+		size_t triCount = indices.size() / 3;
+		if ( triCount == 0 ) return;
+
+		// Triangles using each vertex, of which the first remaining[v] are not emitted yet
+		std::vector<uint> remaining( vertexCount, 0 ), adjacencyOffset( vertexCount + 1, 0 );
+		for ( size_t i = 0; i < triCount * 3; i++ )
+			remaining[indices[i]]++;
+		for ( size_t v = 0; v < vertexCount; v++ )
+			adjacencyOffset[v+1] = adjacencyOffset[v] + remaining[v];
+
+		std::vector<uint> adjacency( triCount * 3 ), fill( adjacencyOffset.begin(), adjacencyOffset.end() - 1 );
+		for ( size_t i = 0; i < triCount * 3; i++ )
+			adjacency[fill[indices[i]]++] = (uint)( i / 3 );
+
+		// Initial scores
+		std::vector<int> cachePos( vertexCount, -1 );
+		std::vector<float> vertexScores( vertexCount ), triScores( triCount, 0.0f );
+		std::vector<bool> emitted( triCount, false );
+
+		for ( size_t v = 0; v < vertexCount; v++ )
+			vertexScores[v] = vertexScore( tables, -1, remaining[v] );
+
+		int best = 0;
+		for ( size_t t = 0; t < triCount; t++ )
+		{
+			triScores[t] = vertexScores[indices[t*3]] + vertexScores[indices[t*3+1]] + vertexScores[indices[t*3+2]];
+			if ( triScores[t] > triScores[best] ) best = (int)t;
+		}
+
+		// Emit triangles
+		std::vector<uint> result;
+		result.reserve( triCount * 3 );
+
+		std::vector<uint> cache, newCache;
+		cache.reserve( OPTIMIZE_CACHE_SIZE + 3 );
+		newCache.reserve( OPTIMIZE_CACHE_SIZE + 3 );
+		size_t nextUnemitted = 0;
+
+		while ( best >= 0 )
+		{
+			const uint* tri = &indices[best * 3];
+			emitted[best] = true;
+			result.insert( result.end(), tri, tri + 3 );
+
+			// Put the vertices of the triangle in front of the cache and remove the triangle from their adjacency
+			newCache.assign( tri, tri + 3 );
+			for ( int i = 0; i < 3; i++ )
+			{
+				uint v = tri[i];
+				uint* adj = &adjacency[adjacencyOffset[v]];
+				uint* last = adj + remaining[v] - 1;
+				std::swap( *std::find( adj, last, (uint)best ), *last );
+				remaining[v]--;
+			}
+
+			for ( size_t i = 0; i < cache.size(); i++ )
+				if ( cache[i] != tri[0] && cache[i] != tri[1] && cache[i] != tri[2] )
+					newCache.push_back( cache[i] );
+
+			// Vertices pushed out of the cache lose their cache score too
+			for ( size_t i = 0; i < newCache.size(); i++ )
+				cachePos[newCache[i]] = i < (size_t)OPTIMIZE_CACHE_SIZE ? (int)i : -1;
+
+			// Update the scores of all affected vertices and their remaining triangles
+			best = -1;
+			float bestScore = -1.0f;
+
+			for ( size_t i = 0; i < newCache.size(); i++ )
+			{
+				uint v = newCache[i];
+				float score = vertexScore( tables, cachePos[v], remaining[v] );
+				float delta = score - vertexScores[v];
+				vertexScores[v] = score;
+
+				for ( uint j = 0; j < remaining[v]; j++ )
+				{
+					uint t = adjacency[adjacencyOffset[v] + j];
+					triScores[t] += delta;
+					if ( triScores[t] > bestScore ) {
+						bestScore = triScores[t];
+						best = (int)t;
+					}
+				}
+			}
+
+			newCache.resize( std::min( newCache.size(), (size_t)OPTIMIZE_CACHE_SIZE ) );
+			cache.swap( newCache );
+
+			// Continue with the next triangle in the original order if the cache is exhausted
+			if ( best < 0 ) {
+				while ( nextUnemitted < triCount && emitted[nextUnemitted] ) nextUnemitted++;
+				if ( nextUnemitted < triCount ) best = (int)nextUnemitted;
+			}
+		}
+
+		indices.swap( result );
+	}
+
+	void Mesh::Optimize()
+	{
+		if ( !indexed ) return;
+
+		// Triangles are only reordered within their submesh
+		if ( submeshes.empty() ) {
+			optimizeTriangles( indices, vertices.size() );
+		} else {
+			// Every submesh is numbered from zero in the order its vertices are first
+			// used, so the work per submesh does not depend on the size of the mesh
+			std::vector<uint> range, local( vertices.size(), (uint)-1 ), global;
+			for ( size_t i = 0; i < submeshes.size(); i++ )
+			{
+				if ( submeshes[i].Count == 0 ) continue;
+				uint* start = &indices[0] + submeshes[i].Start;
+				range.resize( submeshes[i].Count );
+				global.clear();
+
+				for ( uint j = 0; j < submeshes[i].Count; j++ )
+				{
+					uint& l = local[start[j]];
+					if ( l == (uint)-1 ) {
+						l = (uint)global.size();
+						global.push_back( start[j] );
+					}
+					range[j] = l;
+				}
+
+				optimizeTriangles( range, global.size() );
+
+				for ( uint j = 0; j < submeshes[i].Count; j++ )
+					start[j] = global[range[j]];
+				for ( size_t v = 0; v < global.size(); v++ )
+					local[global[v]] = (uint)-1;
+			}
+		}
+
+		// Renumber vertices in the order they are first used, unused ones are kept at the end
+		std::vector<uint> remap( vertices.size(), (uint)-1 );
+		std::vector<Vertex> newVertices;
+		std::vector<Vec4> newTangents;
+		newVertices.reserve( vertices.size() );
+		newTangents.reserve( tangents.size() );
+
+		for ( size_t i = 0; i < indices.size(); i++ )
+		{
+			uint& r = remap[indices[i]];
+			if ( r == (uint)-1 ) {
+				r = (uint)newVertices.size();
+				newVertices.push_back( vertices[indices[i]] );
+				if ( !tangents.empty() ) newTangents.push_back( tangents[indices[i]] );
+			}
+			indices[i] = r;
+		}
+
+		for ( size_t v = 0; v < vertices.size(); v++ )
+		{
+			if ( remap[v] == (uint)-1 ) {
+				newVertices.push_back( vertices[v] );
+				if ( !tangents.empty() ) newTangents.push_back( tangents[v] );
+			}
+		}
+
+		// Clusters keep their triangles, only the vertex numbers change
+		for ( size_t i = 0; i < clusterIndices.size(); i++ )
+			clusterIndices[i] = remap[clusterIndices[i]];
+
+		vertices.swap( newVertices );
+		tangents.swap( newTangents );
+		optimized = true;
+	}
+
+	MeshCacheStats Mesh::CacheStats( uint cacheSize ) const
+	{
+		MeshCacheStats stats = { 0.0f, 0.0f };
+		size_t count = indexed ? indices.size() : vertices.size();
+		if ( count < 3 || cacheSize == 0 ) return stats;
+
+		// Simulate a FIFO cache, a vertex is still cached if less than cacheSize
+		// vertices were transformed since it was transformed itself
+		std::vector<size_t> transformedAt( vertices.size(), 0 );
+		size_t transformed = 0;
+
+		for ( size_t i = 0; i < count; i++ )
+		{
+			uint v = indexed ? indices[i] : (uint)i;
+			if ( transformedAt[v] == 0 || transformed - transformedAt[v] >= cacheSize ) {
+				transformed++;
+				transformedAt[v] = transformed;
+			}
+		}
+
+		stats.ACMR = transformed / float( count / 3 );
+		stats.ATVR = transformed / float( vertices.size() );
+		return stats;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/Mesh.hpp>
+#include <vector>
+#include <unordered_map>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <climits>
+#include <cmath>
+
+namespace GL
+{
+	/*
+		Tangents are computed much like MikkTSpace does: every triangle gets the
+		directions in which its texture coordinates increase, those are
+		projected onto the plane of the vertex normal and averaged with the
+		angle of the corner as weight. Corners are averaged when their position,
+		texture coordinates and normal are equal and their triangles map the
+		texture with the same orientation, so mirrored texture coordinates get
+		their own tangents. Indexed vertices shared by both orientations are
+		split for that.
+	*/
+
+	// Passes with fewer elements than this run on a single thread
+	const size_t TANGENT_PARALLEL_SIZE = 65536;
+
+	// Orientation of the texture mapping of a triangle
+	enum { TANGENT_FLIP_NONE = 2 };
+
+	template <typename F>
+	void parallelRanges( size_t count, F f )
+	{
+		size_t threadCount = count < TANGENT_PARALLEL_SIZE ? 1 : std::max( std::thread::hardware_concurrency(), 1u );
+		if ( threadCount == 1 ) {
+			f( 0, count );
+			return;
+		}
+
+		std::vector<std::thread> threads;
+		for ( size_t i = 0; i < threadCount; i++ )
+			threads.push_back( std::thread( f, count * i / threadCount, count * ( i + 1 ) / threadCount ) );
+		for ( size_t i = 0; i < threadCount; i++ )
+			threads[i].join();
+	}
+
+	inline Vec3 normalizeOr( const Vec3& v, const Vec3& fallback )
+	{
+		float length = v.Length();
+		return length > 0.0f ? v / length : fallback;
+	}
+
+	// Any unit vector perpendicular to n
+	inline Vec3 perpendicular( const Vec3& n )
+	{
+		Vec3 axis = fabsf( n.X ) < 0.9f ? Vec3( 1, 0, 0 ) : Vec3( 0, 1, 0 );
+		return normalizeOr( axis - n * n.Dot( axis ), Vec3( 1, 0, 0 ) );
+	}
+
+	// 0 or 1 for the two orientations, TANGENT_FLIP_NONE without texture space area
+	inline uint textureFlip( const Vertex& v0, const Vertex& v1, const Vertex& v2 )
+	{
+		Vec2 d1 = v1.Tex - v0.Tex, d2 = v2.Tex - v0.Tex;
+		float det = d1.X * d2.Y - d2.X * d1.Y;
+		return det == 0.0f ? TANGENT_FLIP_NONE : det < 0.0f ? 1 : 0;
+	}
+
+	struct vertexKey
+	{
+		uint32_t words[8];
+
+		bool operator==( const vertexKey& o ) const
+		{
+			return memcmp( words, o.words, sizeof( words ) ) == 0;
+		}
+	};
+
+	struct vertexKeyHash
+	{
+		size_t operator()( const vertexKey& k ) const
+		{
+			size_t h = 0;
+			for ( int i = 0; i < 8; i++ )
+				h = h * 31 + k.words[i];
+			return h;
+		}
+	};
+
+	void Mesh::ComputeTangents()
+	{
+		size_t cornerCount = indexed ? indices.size() : vertices.size();
+		size_t triCount = cornerCount / 3;
+
+		std::vector<uint> corners;
+		if ( !indexed ) {
+			corners.resize( cornerCount );
+			for ( size_t i = 0; i < cornerCount; i++ )
+				corners[i] = (uint)i;
+		}
+		uint* corner = indexed ? ( indices.empty() ? 0 : &indices[0] ) : ( corners.empty() ? 0 : &corners[0] );
+
+		// Texture space directions, orientation and area weighted normal of every triangle
+		std::vector<Vec3> triTangent( triCount ), triBitangent( triCount ), triNormal( triCount );
+		std::vector<uchar> triFlip( triCount );
+
+		parallelRanges( triCount, [&] ( size_t begin, size_t end ) {
+			for ( size_t t = begin; t < end; t++ )
+			{
+				const Vertex& v0 = vertices[corner[t*3]];
+				const Vertex& v1 = vertices[corner[t*3+1]];
+				const Vertex& v2 = vertices[corner[t*3+2]];
+
+				Vec3 e1 = v1.Pos - v0.Pos, e2 = v2.Pos - v0.Pos;
+				Vec2 d1 = v1.Tex - v0.Tex, d2 = v2.Tex - v0.Tex;
+				triNormal[t] = e1.Cross( e2 );
+
+				// Triangles without texture space area don't contribute
+				float det = d1.X * d2.Y - d2.X * d1.Y;
+				triFlip[t] = det == 0.0f ? TANGENT_FLIP_NONE : det < 0.0f ? 1 : 0;
+				if ( det == 0.0f ) continue;
+
+				triTangent[t] = normalizeOr( ( e1 * d2.Y - e2 * d1.Y ) / det, Vec3() );
+				triBitangent[t] = normalizeOr( ( e2 * d1.X - e1 * d2.X ) / det, Vec3() );
+			}
+		} );
+
+		// Weld vertices with equal attributes
+		size_t vertexCount = vertices.size();
+		std::unordered_map<vertexKey, uint, vertexKeyHash> weldLookup;
+		std::vector<uint> weld( vertexCount );
+
+		for ( size_t v = 0; v < vertexCount; v++ )
+		{
+			vertexKey key;
+			memcpy( key.words, &vertices[v].Pos, 3 * sizeof( float ) );
+			memcpy( key.words + 3, &vertices[v].Tex, 2 * sizeof( float ) );
+			memcpy( key.words + 5, &vertices[v].Normal, 3 * sizeof( float ) );
+			weld[v] = weldLookup.insert( std::make_pair( key, (uint)weldLookup.size() ) ).first->second;
+		}
+		size_t weldCount = weldLookup.size();
+
+		// Every vertex takes the orientation of its first textured triangle, or of the
+		// first one of its welded vertices, indexed vertices that are also used
+		// with the other orientation are split
+		std::vector<uchar> vertexFlip( vertexCount, TANGENT_FLIP_NONE ), weldFlip( weldCount, 0 );
+		std::vector<bool> weldFlipSet( weldCount, false );
+		for ( size_t c = 0; c < triCount * 3; c++ )
+		{
+			uint v = corner[c], flip = triFlip[c / 3];
+			if ( flip == TANGENT_FLIP_NONE ) continue;
+			if ( vertexFlip[v] == TANGENT_FLIP_NONE ) vertexFlip[v] = (uchar)flip;
+			if ( !weldFlipSet[weld[v]] ) {
+				weldFlip[weld[v]] = (uchar)flip;
+				weldFlipSet[weld[v]] = true;
+			}
+		}
+
+		std::vector<uint> mirror( vertexCount, UINT_MAX );
+		for ( size_t c = 0; c < triCount * 3; c++ )
+		{
+			uint v = corner[c], flip = triFlip[c / 3];
+			if ( flip == TANGENT_FLIP_NONE || flip == vertexFlip[v] ) continue;
+
+			if ( mirror[v] == UINT_MAX ) {
+				mirror[v] = (uint)vertices.size();
+				vertices.push_back( vertices[v] );
+				weld.push_back( weld[v] );
+				vertexFlip.push_back( (uchar)flip );
+			}
+			corner[c] = mirror[v];
+		}
+
+		// Cluster triangles are the same triangles, so they are split the same way
+		for ( size_t c = 0; c + 2 < clusterIndices.size() && vertices.size() > vertexCount; c += 3 )
+		{
+			uint* tri = &clusterIndices[c];
+			uint flip = textureFlip( vertices[tri[0]], vertices[tri[1]], vertices[tri[2]] );
+			for ( int k = 0; k < 3; k++ )
+				if ( flip != TANGENT_FLIP_NONE && flip != vertexFlip[tri[k]] ) tri[k] = mirror[tri[k]];
+		}
+
+		vertexCount = vertices.size();
+		for ( size_t v = 0; v < vertexCount; v++ )
+			if ( vertexFlip[v] == TANGENT_FLIP_NONE ) vertexFlip[v] = weldFlip[weld[v]];
+
+		// Normals of the welded vertices, or their averaged face normals
+		std::vector<Vec3> weldNormal( weldCount );
+		for ( size_t c = 0; c < triCount * 3; c++ )
+			weldNormal[weld[corner[c]]] += triNormal[c / 3];
+
+		for ( size_t v = 0; v < vertexCount; v++ )
+		{
+			Vec3 n = normalizeOr( vertices[v].Normal, Vec3() );
+			if ( hasNormals && n.LengthSqr() > 0.0f ) weldNormal[weld[v]] = n;
+		}
+
+		for ( size_t w = 0; w < weldCount; w++ )
+			weldNormal[w] = normalizeOr( weldNormal[w], Vec3( 0, 0, 1 ) );
+
+		// Corners of every group of welded vertices with the same orientation
+		size_t groupCount = weldCount * 2;
+		std::vector<uint> groupOffset( groupCount + 1, 0 );
+		for ( size_t c = 0; c < triCount * 3; c++ )
+			if ( triFlip[c / 3] != TANGENT_FLIP_NONE ) groupOffset[weld[corner[c]] * 2 + triFlip[c / 3] + 1]++;
+		for ( size_t g = 0; g < groupCount; g++ )
+			groupOffset[g+1] += groupOffset[g];
+
+		std::vector<uint> groupCorners( groupOffset[groupCount] ), fill( groupOffset.begin(), groupOffset.end() - 1 );
+		for ( size_t c = 0; c < triCount * 3; c++ )
+			if ( triFlip[c / 3] != TANGENT_FLIP_NONE ) groupCorners[fill[weld[corner[c]] * 2 + triFlip[c / 3]]++] = (uint)c;
+
+		// Every group gathers its own corners, so the groups can be split between threads
+		std::vector<Vec4> groupTangents( groupCount );
+
+		parallelRanges( groupCount, [&] ( size_t begin, size_t end ) {
+			for ( size_t g = begin; g < end; g++ )
+			{
+				const Vec3& n = weldNormal[g / 2];
+
+				Vec3 tangent, bitangent;
+				for ( uint a = groupOffset[g]; a < groupOffset[g+1]; a++ )
+				{
+					uint c = groupCorners[a], t = c / 3, k = c % 3;
+					const Vec3& p = vertices[corner[c]].Pos;
+
+					// Angle between the edges leaving the corner, in the tangent plane
+					Vec3 a1 = vertices[corner[t*3+(k+1)%3]].Pos - p;
+					Vec3 a2 = vertices[corner[t*3+(k+2)%3]].Pos - p;
+					a1 = normalizeOr( a1 - n * n.Dot( a1 ), Vec3() );
+					a2 = normalizeOr( a2 - n * n.Dot( a2 ), Vec3() );
+					float angle = acosf( std::min( std::max( a1.Dot( a2 ), -1.0f ), 1.0f ) );
+
+					tangent = tangent + normalizeOr( triTangent[t] - n * n.Dot( triTangent[t] ), Vec3() ) * angle;
+					bitangent = bitangent + normalizeOr( triBitangent[t] - n * n.Dot( triBitangent[t] ), Vec3() ) * angle;
+				}
+
+				tangent = normalizeOr( tangent - n * n.Dot( tangent ), Vec3() );
+				if ( tangent.LengthSqr() == 0.0f ) tangent = perpendicular( n );
+
+				float sign = n.Cross( tangent ).Dot( bitangent ) < 0.0f ? -1.0f : 1.0f;
+				groupTangents[g] = Vec4( tangent, sign );
+			}
+		} );
+
+		tangents.resize( vertexCount );
+		for ( size_t v = 0; v < vertexCount; v++ )
+			tangents[v] = groupTangents[weld[v] * 2 + vertexFlip[v]];
+
+		hasTangents = true;
+	}
+
+	bool Mesh::HasTangents() const
+	{
+		return hasTangents;
+	}
+
+	const Vec4* Mesh::Tangents() const
+	{
+		return tangents.empty() ? 0 : &tangents[0];
+	}
+}
\ No newline at end of file
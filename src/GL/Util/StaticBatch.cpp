@@ -0,0 +1,350 @@
+/*
+	Copyright (C) 2012 Alexander Overvoorde
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy of
+	this software and associated documentation files (the "Software"), to deal in
+	the Software without restriction, including without limitation the rights to
+	use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+	the Software, and to permit persons to whom the Software is furnished to do so,
+	subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+	FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+	COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+	IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+	CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE
+*/
+
+#include <GL/Util/StaticBatch.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined( OOGL_SIMD_SSE2 )
+	#include <emmintrin.h>
+#endif
+
+namespace GL
+{
+	/*
+		Internal batching facilities
+	*/
+
+	// Columns of the linear part of a transform and its translation, padded to 4 floats
+	struct affineColumns
+	{
+		float c[4][4];
+	};
+
+	affineColumns pointColumns( const Mat4& m )
+	{
+		affineColumns a;
+		for ( int i = 0; i < 4; i++ )
+		{
+			a.c[i][0] = m.m[i * 4];
+			a.c[i][1] = m.m[i * 4 + 1];
+			a.c[i][2] = m.m[i * 4 + 2];
+			a.c[i][3] = 0.0f;
+		}
+		return a;
+	}
+
+	Vec3 column( const affineColumns& a, int i )
+	{
+		return Vec3( a.c[i][0], a.c[i][1], a.c[i][2] );
+	}
+
+	// The inverse transpose of a matrix with columns a0, a1 and a2 has the columns
+	// a1 x a2, a2 x a0 and a0 x a1 divided by the determinant. Only the sign of
+	// the determinant matters for directions that are normalized afterwards.
+	affineColumns normalColumns( const affineColumns& points, float determinant )
+	{
+		Vec3 a0 = column( points, 0 ), a1 = column( points, 1 ), a2 = column( points, 2 );
+		Vec3 n[3] = { a1.Cross( a2 ), a2.Cross( a0 ), a0.Cross( a1 ) };
+		float sign = determinant < 0.0f ? -1.0f : 1.0f;
+
+		affineColumns a;
+		for ( int i = 0; i < 3; i++ )
+		{
+			a.c[i][0] = n[i].X * sign;
+			a.c[i][1] = n[i].Y * sign;
+			a.c[i][2] = n[i].Z * sign;
+			a.c[i][3] = 0.0f;
+		}
+		for ( int i = 0; i < 4; i++ )
+			a.c[3][i] = 0.0f;
+		return a;
+	}
+
+	// Transforms count vectors that are stride bytes apart in place, points also
+	// get the translation column added and directions can be normalized
+	void transformVectors( const affineColumns& a, Vec3* vectors, size_t stride, size_t count, bool translate, bool normalize )
+	{
+		uchar* p = (uchar*)vectors;
+
+#if defined( OOGL_SIMD_SSE2 )
+		const __m128 c0 = _mm_loadu_ps( a.c[0] );
+		const __m128 c1 = _mm_loadu_ps( a.c[1] );
+		const __m128 c2 = _mm_loadu_ps( a.c[2] );
+		const __m128 c3 = translate ? _mm_loadu_ps( a.c[3] ) : _mm_setzero_ps();
+
+		for ( size_t i = 0; i < count; i++, p += stride )
+		{
+			float* v = (float*)p;
+			__m128 r = _mm_add_ps( _mm_mul_ps( c0, _mm_set1_ps( v[0] ) ), _mm_mul_ps( c1, _mm_set1_ps( v[1] ) ) );
+			r = _mm_add_ps( _mm_add_ps( r, _mm_mul_ps( c2, _mm_set1_ps( v[2] ) ) ), c3 );
+
+			if ( normalize ) {
+				__m128 sq = _mm_mul_ps( r, r );
+				__m128 length = _mm_sqrt_ss( _mm_add_ss( _mm_add_ss( sq, _mm_shuffle_ps( sq, sq, 1 ) ), _mm_shuffle_ps( sq, sq, 2 ) ) );
+				if ( _mm_cvtss_f32( length ) > 0.0f ) r = _mm_div_ps( r, _mm_shuffle_ps( length, length, 0 ) );
+			}
+
+			// Only X, Y and Z are written, the fourth float belongs to the next attribute
+			_mm_storel_pi( (__m64*)v, r );
+			_mm_store_ss( v + 2, _mm_movehl_ps( r, r ) );
+		}
+#else
+		const float t = translate ? 1.0f : 0.0f;
+
+		for ( size_t i = 0; i < count; i++, p += stride )
+		{
+			float* v = (float*)p;
+			float r[3];
+			for ( int j = 0; j < 3; j++ )
+				r[j] = a.c[0][j] * v[0] + a.c[1][j] * v[1] + a.c[2][j] * v[2] + a.c[3][j] * t;
+
+			if ( normalize ) {
+				float length = std::sqrt( r[0] * r[0] + r[1] * r[1] + r[2] * r[2] );
+				if ( length > 0.0f ) r[0] /= length, r[1] /= length, r[2] /= length;
+			}
+
+			v[0] = r[0];
+			v[1] = r[1];
+			v[2] = r[2];
+		}
+#endif
+	}
+
+	// Returns the number of the equal material in materials, after adding it if
+	// there is none, with its maps moved from the source textures to textures
+	uint mergeMaterial( std::vector<MeshMaterial>& materials, std::vector<std::string>& textures, MeshMaterial material, const Mesh& source )
+	{
+		int* maps[] = { &material.DiffuseMap, &material.SpecularMap, &material.NormalMap, &material.AlphaMap };
+		for ( int i = 0; i < 4; i++ )
+		{
+			if ( *maps[i] < 0 ) continue;
+
+			const std::string& path = source.Texture( *maps[i] );
+			std::vector<std::string>::iterator it = std::find( textures.begin(), textures.end(), path );
+			*maps[i] = (int)( it - textures.begin() );
+			if ( it == textures.end() ) textures.push_back( path );
+		}
+
+		for ( size_t i = 0; i < materials.size(); i++ )
+		{
+			const MeshMaterial& m = materials[i];
+			if ( m.Name == material.Name &&
+				m.Ambient.X == material.Ambient.X && m.Ambient.Y == material.Ambient.Y && m.Ambient.Z == material.Ambient.Z &&
+				m.Diffuse.X == material.Diffuse.X && m.Diffuse.Y == material.Diffuse.Y && m.Diffuse.Z == material.Diffuse.Z &&
+				m.Specular.X == material.Specular.X && m.Specular.Y == material.Specular.Y && m.Specular.Z == material.Specular.Z &&
+				m.Shininess == material.Shininess && m.Opacity == material.Opacity &&
+				m.DiffuseMap == material.DiffuseMap && m.SpecularMap == material.SpecularMap &&
+				m.NormalMap == material.NormalMap && m.AlphaMap == material.AlphaMap )
+				return (uint)i;
+		}
+
+		materials.push_back( material );
+		return (uint)( materials.size() - 1 );
+	}
+
+	// Triangles of one instance that use the same merged material
+	struct batchRange
+	{
+		uint material;
+		uint instance;
+		uint start, count;
+
+		bool operator<( const batchRange& other ) const
+		{
+			return material < other.material;
+		}
+	};
+
+	/*
+		Static batch
+	*/
+
+	uint StaticBatch::Add( const Mesh& mesh, const Mat4& transform )
+	{
+		instance i = { &mesh, transform };
+		instances.push_back( i );
+		return (uint)( instances.size() - 1 );
+	}
+
+	uint StaticBatch::InstanceCount() const
+	{
+		return (uint)instances.size();
+	}
+
+	void StaticBatch::Clear()
+	{
+		instances.clear();
+	}
+
+	Mesh StaticBatch::Build() const
+	{
+		Mesh batch;
+		batch.indexed = true;
+		batch.hasNormals = !instances.empty();
+		if ( !instances.empty() ) batch.creaseAngle = instances[0].mesh->creaseAngle;
+
+		size_t vertexCount = 0, indexCount = 0;
+		bool anyMaterials = false, anyTangents = false, allTangents = !instances.empty();
+
+		for ( size_t i = 0; i < instances.size(); i++ )
+		{
+			const Mesh& mesh = *instances[i].mesh;
+			vertexCount += mesh.vertices.size();
+			indexCount += mesh.indexed ? mesh.indices.size() : mesh.vertices.size();
+
+			batch.hasTexCoords |= mesh.hasTexCoords;
+			batch.hasNormals &= mesh.hasNormals;
+			anyMaterials |= !mesh.materials.empty();
+			anyTangents |= !mesh.tangents.empty();
+			allTangents &= !mesh.tangents.empty();
+		}
+
+		// Every instance is split into ranges of triangles with the same material,
+		// which are then sorted to make the materials contiguous
+		std::vector<batchRange> ranges;
+
+		for ( size_t i = 0; i < instances.size(); i++ )
+		{
+			const Mesh& mesh = *instances[i].mesh;
+			uint corners = (uint)( mesh.indexed ? mesh.indices.size() : mesh.vertices.size() );
+
+			if ( mesh.submeshes.empty() ) {
+				uint material = anyMaterials ? mergeMaterial( batch.materials, batch.textures, MeshMaterial(), mesh ) : 0;
+				batchRange range = { material, (uint)i, 0, corners };
+				ranges.push_back( range );
+				continue;
+			}
+
+			std::vector<uint> materialMap( mesh.materials.size() );
+			for ( size_t m = 0; m < mesh.materials.size(); m++ )
+				materialMap[m] = mergeMaterial( batch.materials, batch.textures, mesh.materials[m], mesh );
+
+			for ( size_t s = 0; s < mesh.submeshes.size(); s++ )
+			{
+				const MeshSubmesh& submesh = mesh.submeshes[s];
+				batchRange range = { materialMap[submesh.Material], (uint)i, submesh.Start, submesh.Count };
+				ranges.push_back( range );
+			}
+		}
+
+		std::stable_sort( ranges.begin(), ranges.end() );
+
+		// Vertices of every instance are appended in order and transformed in place
+		batch.vertices.reserve( vertexCount );
+		if ( allTangents ) batch.tangents.reserve( vertexCount );
+
+		std::vector<uint> baseVertex( instances.size() );
+		std::vector<bool> mirrored( instances.size() );
+
+		for ( size_t i = 0; i < instances.size(); i++ )
+		{
+			const Mesh& mesh = *instances[i].mesh;
+			size_t base = batch.vertices.size();
+			size_t count = mesh.vertices.size();
+			baseVertex[i] = (uint)base;
+
+			affineColumns points = pointColumns( instances[i].transform );
+			float determinant = column( points, 0 ).Dot( column( points, 1 ).Cross( column( points, 2 ) ) );
+			affineColumns normals = normalColumns( points, determinant );
+			mirrored[i] = determinant < 0.0f;
+
+			batch.vertices.insert( batch.vertices.end(), mesh.vertices.begin(), mesh.vertices.end() );
+			if ( count == 0 ) continue;
+
+			Vertex* vertices = &batch.vertices[base];
+			transformVectors( points, &vertices[0].Pos, sizeof( Vertex ), count, true, false );
+			transformVectors( normals, &vertices[0].Normal, sizeof( Vertex ), count, false, true );
+
+			if ( !allTangents ) continue;
+
+			batch.tangents.insert( batch.tangents.end(), mesh.tangents.begin(), mesh.tangents.end() );
+			Vec4* tangents = &batch.tangents[base];
+			transformVectors( points, (Vec3*)&tangents[0], sizeof( Vec4 ), count, false, true );
+
+			// The bitangent is transformed like the tangent, its sign relative to
+			// the new normal and tangent can change under mirroring or shearing
+			for ( size_t v = 0; v < count; v++ )
+			{
+				const Vec4& t = mesh.tangents[v];
+				Vec3 bitangent = mesh.vertices[v].Normal.Cross( Vec3( t.X, t.Y, t.Z ) ) * t.W;
+				transformVectors( points, &bitangent, sizeof( Vec3 ), 1, false, false );
+
+				Vec3 tangent( tangents[v].X, tangents[v].Y, tangents[v].Z );
+				tangents[v].W = vertices[v].Normal.Cross( tangent ).Dot( bitangent ) < 0.0f ? -1.0f : 1.0f;
+			}
+		}
+
+		// Indices in material order, with the winding of mirrored instances
+		// reversed to keep their front faces pointing outwards
+		batch.indices.resize( indexCount );
+		uint* first = indexCount > 0 ? &batch.indices[0] : 0;
+		uint* out = first;
+
+		for ( size_t r = 0; r < ranges.size(); r++ )
+		{
+			const batchRange& range = ranges[r];
+			const Mesh& mesh = *instances[range.instance].mesh;
+			uint base = baseVertex[range.instance];
+			bool flip = mirrored[range.instance];
+			if ( range.count < 3 ) continue;
+
+			uint start = (uint)( out - first );
+			if ( anyMaterials && ( batch.submeshes.empty() || batch.submeshes.back().Material != range.material ) ) {
+				MeshSubmesh submesh = { range.material, start, 0 };
+				batch.submeshes.push_back( submesh );
+			}
+
+			// Corners 1 and 2 are swapped to flip the winding
+			uint second = flip ? 2 : 1, third = flip ? 1 : 2;
+			uint end = range.start + range.count / 3 * 3;
+
+			if ( mesh.indexed ) {
+				const uint* in = &mesh.indices[0];
+				for ( uint c = range.start; c < end; c += 3, out += 3 )
+				{
+					out[0] = base + in[c];
+					out[1] = base + in[c + second];
+					out[2] = base + in[c + third];
+				}
+			} else {
+				for ( uint c = range.start; c < end; c += 3, out += 3 )
+				{
+					out[0] = base + c;
+					out[1] = base + c + second;
+					out[2] = base + c + third;
+				}
+			}
+
+			if ( anyMaterials ) batch.submeshes.back().Count = (uint)( out - first ) - batch.submeshes.back().Start;
+		}
+
+		// Ranges with an incomplete triangle at the end leave unused room
+		batch.indices.resize( out - first );
+
+		batch.hasTangents = allTangents;
+		if ( anyTangents && !allTangents ) batch.ComputeTangents();
+
+		batch.ComputeBounds();
+
+		return batch;
+	}
+}
\ No newline at end of file